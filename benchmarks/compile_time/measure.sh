@@ -0,0 +1,69 @@
+#!/bin/sh
+# Compares the compile time of traits.cpp when namedargs is consumed as
+# headers, through a precompiled header, and as the C++20 module.
+#
+#   CXX=g++-14 benchmarks/compile_time/measure.sh [runs]
+#
+# The module is built with `-fmodules-ts` (GCC) or `--precompile` (Clang);
+# a failure there is reported and the other modes are still measured.
+set -u
+cd "$(dirname "$0")"
+CXX=${CXX:-c++}
+RUNS=${1:-5}
+INCLUDE=../../include
+MODULE=../../modules/namedargs.cppm
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+FLAGS="-std=c++20 -O2 -I$INCLUDE"
+
+now() { date +%s.%N; }
+
+# measure <label> <command...>: prints the mean wall time of RUNS runs
+measure() {
+  label=$1
+  shift
+  total=0
+  for _ in $(seq "$RUNS"); do
+    start=$(now)
+    if ! "$@" >"$OUT/log" 2>&1; then
+      echo "$label: failed ($(head -n 1 "$OUT/log"))"
+      return
+    fi
+    total=$(echo "$total $start $(now)" | awk '{ print $1 + $3 - $2 }')
+  done
+  echo "$total $RUNS $label" | awk '{ printf "%-8s %.3f s\n", $3 ":", $1 / $2 }'
+}
+
+# Headers
+measure header $CXX $FLAGS -c traits.cpp -o "$OUT/header.o"
+
+# Precompiled header
+mkdir -p "$OUT/pch/namedargs"
+printf '#include <namedargs/convert.hpp>\n#include <namedargs/datetime.hpp>\n' \
+  >"$OUT/pch/all.hpp"
+if $CXX $FLAGS -x c++-header "$OUT/pch/all.hpp" -o "$OUT/pch/all.hpp.gch" \
+  2>/dev/null; then
+  measure pch $CXX $FLAGS -include "$OUT/pch/all.hpp" -c traits.cpp \
+    -o "$OUT/pch.o"
+else
+  echo "pch:     failed to build the precompiled header"
+fi
+
+# Module (the BMI is built once, outside the measurement)
+case $($CXX --version) in
+*clang*)
+  $CXX $FLAGS --precompile -x c++-module $MODULE -o "$OUT/namedargs.pcm" \
+    >"$OUT/log" 2>&1 &&
+    measure module $CXX $FLAGS -DNAMEDARGS_BENCH_MODULE \
+      -fmodule-file=namedargs="$OUT/namedargs.pcm" -c traits.cpp \
+      -o "$OUT/module.o" ||
+    echo "module:  failed to build the BMI ($(head -n 1 "$OUT/log"))"
+  ;;
+*)
+  (cd "$OUT" && $CXX $FLAGS -I"$OLDPWD/$INCLUDE" -fmodules-ts -c \
+    -x c++ "$OLDPWD/$MODULE" -o namedargs.o >log 2>&1) &&
+    measure module sh -c "cd '$OUT' && $CXX $FLAGS -fmodules-ts \
+      -DNAMEDARGS_BENCH_MODULE -c '$PWD/traits.cpp' -o module.o" ||
+    echo "module:  failed to build the BMI ($(head -n 1 "$OUT/log"))"
+  ;;
+esac
@@ -0,0 +1,46 @@
+// A translation unit instantiating several ArgParserTraits, compiled by
+// measure.sh with the headers, a precompiled header or the module.
+#if defined(NAMEDARGS_BENCH_MODULE)
+#include <string_view> // Before the import; GCC rejects the reverse order
+#include <tuple>
+import namedargs;
+#else
+#include <namedargs/convert.hpp>
+#include <namedargs/datetime.hpp>
+#endif
+
+namespace na = namedargs;
+
+#define NAMEDARGS_BENCH_TRAITS(N)                                              \
+  struct params##N {                                                           \
+    int num;                                                                   \
+    std::string_view str;                                                      \
+    long long other;                                                           \
+  };                                                                           \
+  template <>                                                                  \
+  struct na::ArgParserTraits<params##N> {                                      \
+    static constexpr auto fields = std::tuple{                                 \
+      na::field("num", &params##N::num, N),                                    \
+      na::field("str", &params##N::str, ""),                                   \
+      na::field("other", &params##N::other, 0),                                \
+    };                                                                         \
+    static constexpr params##N convert(const na::ArgParser& p) {               \
+      return na::convert_fields<params##N, fields>(p);                         \
+    }                                                                          \
+  };                                                                           \
+  int use##N(std::string_view sv) {                                            \
+    return na::parse_args<params##N>(sv).num;                                  \
+  }
+
+NAMEDARGS_BENCH_TRAITS(0)
+NAMEDARGS_BENCH_TRAITS(1)
+NAMEDARGS_BENCH_TRAITS(2)
+NAMEDARGS_BENCH_TRAITS(3)
+NAMEDARGS_BENCH_TRAITS(4)
+NAMEDARGS_BENCH_TRAITS(5)
+NAMEDARGS_BENCH_TRAITS(6)
+NAMEDARGS_BENCH_TRAITS(7)
+
+int main(int argc, char** argv) {
+  return argc > 1 ? use0(argv[1]) + use7(argv[1]) : 0;
+}
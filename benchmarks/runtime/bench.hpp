@@ -0,0 +1,111 @@
+/// @file bench.hpp
+/// Minimal harness of the runtime benchmarks: runs a phase repeatedly,
+/// optionally under hardware counters, and prints one row per phase with
+/// the costs normalized per input byte and per argument.
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib> // std::strtoul
+#include <string>
+#include <string_view>
+#include "perf_counters.hpp"
+
+namespace namedargs::bench {
+  /// Keeps the compiler from optimizing away the computation of `value`
+  template <class T>
+  inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  struct options {
+    bool perf = false;          // --perf
+    std::size_t args = 64;      // --args N
+    std::size_t iterations = 0; // --iterations N (0: about 0.2 s/phase)
+  };
+
+  inline options parse_options(int argc, char** argv) {
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg = argv[i];
+      if (arg == "--perf")
+        opts.perf = true;
+      else if (arg == "--args" and i + 1 < argc)
+        opts.args = std::strtoul(argv[++i], nullptr, 10);
+      else if (arg == "--iterations" and i + 1 < argc)
+        opts.iterations = std::strtoul(argv[++i], nullptr, 10);
+      else
+        std::fprintf(stderr,
+                     "usage: %s [--perf] [--args N] [--iterations N]\n",
+                     argv[0]);
+    }
+    return opts;
+  }
+
+  /// Size of the work a phase does in one iteration
+  struct workload {
+    std::size_t bytes;
+    std::size_t args;
+  };
+
+  class runner {
+  public:
+    explicit runner(const options& opts)
+      : opts_(opts), counters_(opts.perf) {
+      if (opts.perf and not counters_.available())
+        std::printf("# hardware counters unavailable (perf_event_open "
+                    "failed); reporting wall-clock time only\n");
+      std::printf("%-12s %10s %10s", "phase", "ns/byte", "ns/arg");
+      if (counters_.available())
+        std::printf(" %10s %10s %12s %10s %10s", "cyc/byte", "ins/byte",
+                    "brmiss/arg", "L1d/arg", "LLC/arg");
+      std::printf("\n");
+    }
+
+    /// Runs `f` and prints its row
+    template <class F>
+    void run(const char* name, workload w, F&& f) {
+      std::size_t n = opts_.iterations;
+      if (n == 0) {
+        // Calibrate to about 0.2 s
+        const auto t0 = clock::now();
+        std::size_t k = 0;
+        for (; clock::now() - t0 < std::chrono::milliseconds(20); ++k)
+          f();
+        n = k * 10 + 1;
+      }
+      counters_.start();
+      const auto t0 = clock::now();
+      for (std::size_t i = 0; i < n; ++i)
+        f();
+      const auto t1 = clock::now();
+      const perf_values values = counters_.stop();
+
+      const double ns = std::chrono::duration<double, std::nano>(t1 - t0)
+                          .count()
+                        / static_cast<double>(n);
+      const double bytes = static_cast<double>(w.bytes);
+      const double args = static_cast<double>(w.args);
+      std::printf("%-12s %10.3f %10.2f", name, ns / bytes, ns / args);
+      if (counters_.available()) {
+        auto print = [&](perf_event e, double per, int width) {
+          if (const auto& v = values[static_cast<std::size_t>(e)])
+            std::printf(" %*.3f", width, *v / static_cast<double>(n) / per);
+          else
+            std::printf(" %*s", width, "n/a");
+        };
+        print(perf_event::cycles, bytes, 10);
+        print(perf_event::instructions, bytes, 10);
+        print(perf_event::branch_misses, args, 12);
+        print(perf_event::l1d_misses, args, 10);
+        print(perf_event::llc_misses, args, 10);
+      }
+      std::printf("\n");
+    }
+
+  private:
+    using clock = std::chrono::steady_clock;
+    options opts_;
+    perf_counters counters_;
+  };
+} // namespace namedargs::bench
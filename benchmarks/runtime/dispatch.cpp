@@ -0,0 +1,98 @@
+/// @file dispatch.cpp
+/// Token start dispatch on a mixed input (identifiers, integers, strings,
+/// punctuators and irregular whitespace in a pseudo-random order):
+///
+///   chain       the sequence of predicate tests next_token used before
+///               the first-character table
+///   table       ArgParser::next_token
+///
+///   dispatch_bench [--perf] [--args N] [--iterations N]
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <namedargs/parser.hpp>
+#include "bench.hpp"
+
+namespace na = namedargs;
+namespace nb = namedargs::bench;
+
+namespace {
+  using Parser = na::ArgParser;
+
+  std::string_view next_token_chain(std::string_view sv, Parser::Token& tok) {
+    while (not sv.empty()) {
+      if (na::isspace(sv.front())) {
+        sv = Parser::skip_whitespaces(sv);
+        continue;
+      }
+      if (const std::uint32_t mask =
+            Parser::kind_table[static_cast<unsigned char>(sv.front())];
+          mask != 0)
+        if (const std::size_t size =
+              Parser::tokenize_value(sv, tok, mask, {}))
+          return sv.substr(size);
+      if (na::isident1(sv.front()))
+        return Parser::tokenize_identifier(sv, tok);
+      if (na::ispunct(sv.front()))
+        return Parser::tokenize_punct(sv, tok);
+      throw na::parse_error("unexpected character", sv.data());
+    }
+    tok = {na::TokenKind::eof, sv, {}};
+    return sv;
+  }
+
+  std::string make_input(std::size_t args) {
+    constexpr std::string_view spaces[] = {"", " ", "  ", "\t", " \n "};
+    std::string input;
+    std::uint32_t x = 12345;
+    auto next = [&x] { return x = x * 1103515245 + 12345, x >> 16; };
+    for (std::size_t i = 0; i < args; ++i) {
+      input += i == 0 ? "" : ",";
+      input += spaces[next() % 5];
+      input += "k" + std::to_string(next() % 1000);
+      input += spaces[next() % 5];
+      input += "=";
+      input += spaces[next() % 5];
+      switch (next() % 3) {
+      case 0:
+        input += std::to_string(next());
+        break;
+      case 1:
+        input += "'" + std::string(next() % 8, 'v') + "'";
+        break;
+      default:
+        input += "(" + std::to_string(next() % 10) + ")";
+      }
+    }
+    return input;
+  }
+
+  template <class Next>
+  std::size_t count_tokens(std::string_view sv, Next next) {
+    Parser::Token tok{};
+    std::size_t n = 0;
+    do {
+      sv = next(sv, tok);
+      ++n;
+    } while (tok.kind != na::TokenKind::eof);
+    return n;
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  const nb::options opts = nb::parse_options(argc, argv);
+  const std::string input = make_input(opts.args);
+  const nb::workload w{input.size(), opts.args};
+
+  std::printf("# %zu arguments, %zu bytes\n", opts.args, input.size());
+  nb::runner runner(opts);
+  runner.run("chain", w, [&] {
+    nb::do_not_optimize(count_tokens(input, next_token_chain));
+  });
+  runner.run("table", w, [&] {
+    nb::do_not_optimize(count_tokens(input, [](auto sv, auto& tok) {
+      return Parser::next_token(sv, tok);
+    }));
+  });
+}
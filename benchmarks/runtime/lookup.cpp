@@ -0,0 +1,93 @@
+/// @file lookup.cpp
+/// ArgParser::find on argument sets of increasing size, the keys looked up
+/// in a pseudo-random order, half of them missing:
+///
+///   sorted      binary search on the sorted keys (after `execute()`)
+///   frozen      Eytzinger layout (after `freeze()`)
+///   scan_args   count of the integer arguments through `args()`
+///   scan_kinds  the same through the packed `kinds()`
+///
+/// The sizes are 2^6, 2^9, ..., 2^21 arguments, or `--args` alone.
+///
+///   lookup_bench [--perf] [--args N] [--iterations N]
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <namedargs/parser.hpp>
+#include "bench.hpp"
+
+namespace na = namedargs;
+namespace nb = namedargs::bench;
+
+namespace {
+  /// 12 hexadecimal digits of a bijective hash of `i`
+  std::string hex_id(std::uint64_t i) {
+    constexpr char digits[] = "0123456789abcdef";
+    std::uint64_t x = (i * 0x9E3779B97F4A7C15) >> 16;
+    std::string id(12, '0');
+    for (char& c : id) {
+      c = digits[x & 15];
+      x >>= 4;
+    }
+    return id;
+  }
+
+  /// `k0a3f... = 0, k5e12... = 'v', ...` (few keys share their first 8
+  /// bytes), and the keys present and missing, shuffled
+  std::string make_input(std::size_t args, std::vector<std::string>& keys) {
+    std::string input;
+    for (std::size_t i = 0; i < args; ++i) {
+      const std::string id = hex_id(i);
+      input += (i == 0 ? "" : ", ") + ("k" + id) + " = "
+               + (i % 2 == 0 ? std::to_string(i) : "'v'");
+      keys.push_back("k" + id);
+      keys.push_back("k" + hex_id(i + args));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+    return input;
+  }
+
+  void run_size(const nb::options& opts, std::size_t args) {
+    std::vector<std::string> keys;
+    const std::string input = make_input(args, keys);
+    na::ArgParser parser(input);
+    parser.execute();
+    const nb::workload w{input.size(), keys.size()};
+
+    std::printf("# %zu arguments\n", args);
+    nb::runner runner(opts);
+    auto lookups = [&] {
+      std::size_t found = 0;
+      for (const auto& key : keys)
+        found += parser.find(key).second;
+      nb::do_not_optimize(found);
+    };
+    runner.run("sorted", w, lookups);
+    parser.freeze();
+    runner.run("frozen", w, lookups);
+    runner.run("scan_args", w, [&] {
+      std::size_t ints = 0;
+      for (const auto& arg : parser.args())
+        ints += arg.second.index() == 0;
+      nb::do_not_optimize(ints);
+    });
+    runner.run("scan_kinds", w, [&] {
+      nb::do_not_optimize(std::ranges::count(parser.kinds(), 0));
+    });
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  bool sized = false;
+  for (int i = 1; i < argc; ++i)
+    sized = sized or std::string_view(argv[i]) == "--args";
+  const nb::options opts = nb::parse_options(argc, argv);
+  if (sized)
+    run_size(opts, opts.args);
+  else
+    for (std::size_t args = 64; args <= std::size_t{1} << 21; args *= 8)
+      run_size(opts, args);
+}
@@ -0,0 +1,140 @@
+/// @file parse.cpp
+/// Phases of argument parsing on a generated input of `--args` arguments:
+///
+///   tokenize    ArgParser::tokenize
+///   execute     tokenize, parse and sort (through the structural index
+///               from structural_index_threshold bytes)
+///   index       build_structural_index alone
+///   indexed     ArgParser::execute_indexed at any size
+///   parallel    ArgParser::execute_parallel on every hardware thread
+///   std_sort    std::sort of the parsed arguments, shuffled, by key
+///   msd_sort    msd_sort of the same, as `execute()` finalizes
+///   prefix_sort std::sort of the same by prefixed_key
+///   find        ArgParser::find of every key and as many missing keys
+///   find_view   the same lookups by binary search on the keys alone
+///   parse_args  parse_args<T> of an aggregate with 8 of the keys
+///
+///   parse_bench [--perf] [--args N] [--iterations N]
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <namedargs/aggregate.hpp>
+#include <namedargs/parser.hpp>
+#include <namedargs/sort.hpp>
+#include "bench.hpp"
+
+namespace na = namedargs;
+namespace nb = namedargs::bench;
+
+namespace {
+  struct bench_params {
+    std::int64_t a0, a1, a2, a3;
+    std::string_view s0, s1, s2, s3;
+  };
+
+  /// `a0 = 0, s0 = 'value 0', key_0002 = 2, ...`: integers and strings
+  /// alternate, the first 8 keys are the fields of `bench_params`
+  std::string make_input(std::size_t args, std::vector<std::string>& keys) {
+    std::string input;
+    for (std::size_t i = 0; i < args; ++i) {
+      std::string key;
+      if (i < 8)
+        key = (i % 2 == 0 ? "a" : "s") + std::to_string(i / 2);
+      else
+        key = "key_" + std::to_string(1000000 + i).substr(1);
+      input += (i == 0 ? "" : ", ") + key + " = ";
+      input += i % 2 == 0 ? std::to_string(i * 7919)
+                          : "'value " + std::to_string(i) + "'";
+      keys.push_back(std::move(key));
+    }
+    return input;
+  }
+} // namespace
+
+NAMEDARGS_AGGREGATE(bench_params, a0, a1, a2, a3, s0, s1, s2, s3);
+
+int main(int argc, char** argv) {
+  const nb::options opts = nb::parse_options(argc, argv);
+  std::vector<std::string> keys;
+  const std::string input = make_input(opts.args, keys);
+  for (std::size_t i = 0; i < opts.args; ++i)
+    keys.push_back("missing_" + std::to_string(i));
+  const nb::workload w{input.size(), opts.args};
+
+  std::printf("# %zu arguments, %zu bytes\n", opts.args, input.size());
+  nb::runner runner(opts);
+  runner.run("tokenize", w, [&] {
+    na::ArgParser parser(input);
+    nb::do_not_optimize(parser.tokenize());
+  });
+  runner.run("execute", w, [&] {
+    na::ArgParser parser(input);
+    parser.execute();
+    nb::do_not_optimize(parser.args().size());
+  });
+  runner.run("index", w, [&] {
+    nb::do_not_optimize(na::build_structural_index(input).positions.size());
+  });
+  runner.run("indexed", w, [&] {
+    na::ArgParser parser(input);
+    parser.execute_indexed();
+    nb::do_not_optimize(parser.args().size());
+  });
+  runner.run("parallel", w, [&] {
+    na::ArgParser parser(input);
+    parser.execute_parallel(std::thread::hardware_concurrency());
+    nb::do_not_optimize(parser.args().size());
+  });
+  na::ArgParser parsed(input);
+  parsed.execute();
+  using arg = std::pair<std::string_view, na::ArgParser::ArgType>;
+  std::vector<arg> shuffled(parsed.args().begin(), parsed.args().end());
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+  std::vector<arg> sorted;
+  runner.run("std_sort", w, [&] {
+    sorted = shuffled;
+    std::sort(sorted.begin(), sorted.end(), [](const auto& x, const auto& y) {
+      return x.first.compare(y.first) < 0;
+    });
+    nb::do_not_optimize(sorted.data());
+  });
+  runner.run("msd_sort", w, [&] {
+    sorted = shuffled;
+    nb::do_not_optimize(na::msd_sort(sorted.begin(), sorted.end(),
+                                     [](const auto& x) { return x.first; }));
+  });
+  using prefixed_arg = std::pair<na::prefixed_key, na::ArgParser::ArgType>;
+  const std::vector<prefixed_arg> prefixed(shuffled.begin(), shuffled.end());
+  std::vector<prefixed_arg> prefix_sorted;
+  runner.run("prefix_sort", w, [&] {
+    prefix_sorted = prefixed;
+    std::sort(prefix_sorted.begin(), prefix_sorted.end(),
+              [](const auto& x, const auto& y) { return x.first < y.first; });
+    nb::do_not_optimize(prefix_sorted.data());
+  });
+  runner.run("find", w, [&] {
+    std::size_t found = 0;
+    for (const auto& key : keys)
+      found += parsed.find(key).second;
+    nb::do_not_optimize(found);
+  });
+  runner.run("find_view", w, [&] {
+    const auto args = parsed.args();
+    std::size_t found = 0;
+    for (const auto& key : keys) {
+      const auto it =
+        std::ranges::lower_bound(args, std::string_view(key), {},
+                                 [](const auto& x) { return x.first; });
+      found += it != args.end() and it->first == key;
+    }
+    nb::do_not_optimize(found);
+  });
+  runner.run("parse_args", w, [&] {
+    nb::do_not_optimize(na::parse_args<bench_params>(input));
+  });
+}
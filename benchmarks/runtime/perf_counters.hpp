@@ -0,0 +1,134 @@
+/// @file perf_counters.hpp
+/// Hardware performance counters read with perf_event_open(2). Each event
+/// is opened on its own, so that an event the CPU, the kernel or a
+/// container does not allow is reported as unavailable instead of failing
+/// the whole measurement.
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#if __has_include(<linux/perf_event.h>)
+#include <cstring> // std::memset
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define NAMEDARGS_HAS_PERF_EVENT 1
+#endif
+
+namespace namedargs::bench {
+  enum class perf_event : std::size_t {
+    cycles,
+    instructions,
+    branch_misses,
+    l1d_misses,
+    llc_misses,
+  };
+
+  inline constexpr std::size_t perf_event_count = 5;
+
+  constexpr std::string_view perf_event_name(perf_event e) {
+    constexpr std::string_view names[] = {"cycles", "instructions",
+                                          "branch-misses", "L1d-misses",
+                                          "LLC-misses"};
+    return names[static_cast<std::size_t>(e)];
+  }
+
+  /// Counter values of one measurement; nullopt if an event is unavailable
+  using perf_values = std::array<std::optional<double>, perf_event_count>;
+
+  class perf_counters {
+  public:
+    /// Opens the counters of the calling thread. Set `enabled` to false to
+    /// skip them entirely.
+    explicit perf_counters(bool enabled = true) {
+      fds_.fill(-1);
+#ifdef NAMEDARGS_HAS_PERF_EVENT
+      if (not enabled)
+        return;
+      constexpr std::uint64_t cache_read_miss =
+        (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      const std::pair<std::uint32_t, std::uint64_t> events[] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cache_read_miss},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+      };
+      for (std::size_t i = 0; i < perf_event_count; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = events[i].first;
+        attr.config = events[i].second;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+          PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fds_[i] = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      }
+#else
+      (void)enabled;
+#endif
+    }
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    ~perf_counters() {
+#ifdef NAMEDARGS_HAS_PERF_EVENT
+      for (int fd : fds_)
+        if (fd >= 0)
+          close(fd);
+#endif
+    }
+
+    /// True if at least one event could be opened
+    bool available() const noexcept {
+      for (int fd : fds_)
+        if (fd >= 0)
+          return true;
+      return false;
+    }
+
+    void start() noexcept {
+#ifdef NAMEDARGS_HAS_PERF_EVENT
+      for (int fd : fds_)
+        if (fd >= 0) {
+          ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+          ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /// Stops counting and returns the counts since `start()`, scaled up if
+    /// the kernel multiplexed the counters
+    perf_values stop() noexcept {
+      perf_values values{};
+#ifdef NAMEDARGS_HAS_PERF_EVENT
+      for (int fd : fds_)
+        if (fd >= 0)
+          ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      for (std::size_t i = 0; i < perf_event_count; ++i) {
+        // value, time_enabled, time_running
+        std::uint64_t data[3]{};
+        if (fds_[i] < 0 or read(fds_[i], data, sizeof(data)) != sizeof(data)
+            or data[2] == 0)
+          continue;
+        values[i] = static_cast<double>(data[0])
+                    * static_cast<double>(data[1])
+                    / static_cast<double>(data[2]);
+      }
+#endif
+      return values;
+    }
+
+  private:
+    std::array<int, perf_event_count> fds_{};
+  };
+} // namespace namedargs::bench
@@ -0,0 +1,99 @@
+/// @file pool.cpp
+/// Concurrent parse_args<T> on 1, 8 and 64 threads, each parsing the input
+/// of `--args` arguments 200 times:
+///
+///   fresh/N     a new ArgParser per parse, as parse_args did before
+///               parser_pool
+///   pooled/N    parse_args<T>, with the parsers borrowed from parser_pool
+///
+/// The times are per byte and argument of all the parses; `allocs/parse`
+/// is the number of calls to operator new per parse.
+///
+///   pool_bench [--perf] [--args N] [--iterations N]
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib> // std::malloc, std::free
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <namedargs/aggregate.hpp>
+#include <namedargs/parser.hpp>
+#include "bench.hpp"
+
+namespace na = namedargs;
+namespace nb = namedargs::bench;
+
+namespace {
+  std::atomic<std::size_t> allocations{0};
+
+  struct pool_params {
+    std::int64_t a0, a1;
+    std::string_view s0, s1;
+  };
+} // namespace
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+NAMEDARGS_AGGREGATE(pool_params, a0, a1, s0, s1);
+
+namespace {
+  constexpr std::size_t parses_per_thread = 200;
+
+  pool_params parse_fresh(std::string_view input) {
+    na::ArgParser parser(input);
+    parser.execute();
+    return na::ArgParserTraits<pool_params>::convert(parser);
+  }
+
+  /// Runs `parses_per_thread` parses on each of `threads` threads
+  template <class Parse>
+  void run_threads(unsigned threads, std::string_view input, Parse parse) {
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t)
+      pool.emplace_back([&] {
+        for (std::size_t i = 0; i < parses_per_thread; ++i)
+          nb::do_not_optimize(parse(input));
+      });
+    for (auto& thread : pool)
+      thread.join();
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  const nb::options opts = nb::parse_options(argc, argv);
+  std::string input = "a0 = 1, a1 = 2, s0 = 'x', s1 = 'y'";
+  for (std::size_t i = 4; i < opts.args; ++i)
+    input += ", key" + std::to_string(i) + " = " + std::to_string(i);
+
+  std::printf("# %zu arguments, %zu bytes\n", opts.args, input.size());
+  nb::runner runner(opts);
+  for (unsigned threads : {1u, 8u, 64u}) {
+    const std::size_t parses = threads * parses_per_thread;
+    const nb::workload w{input.size() * parses, opts.args * parses};
+    auto report = [&](const char* name, auto parse) {
+      const std::string row = name + ("/" + std::to_string(threads));
+      runner.run(row.c_str(), w, [&] { run_threads(threads, input, parse); });
+      const std::size_t before = allocations.load();
+      run_threads(threads, input, parse);
+      std::printf("%-12s allocs/parse %.2f\n", "",
+                  static_cast<double>(allocations.load() - before)
+                    / static_cast<double>(parses));
+    };
+    report("fresh", parse_fresh);
+    report("pooled", [](std::string_view sv) {
+      return na::parse_args<pool_params>(sv);
+    });
+  }
+}
@@ -0,0 +1,103 @@
+/// @file visit.cpp
+/// Dispatch on the kind of parsed values, integers and strings in a
+/// pseudo-random order, each assigned to a sink taking both:
+///
+///   std_visit   std::visit on std::variant
+///   tagged      namedargs::visit on ArgParser::ArgType (tagged_value)
+///   assign_arg  assign_arg of the same values parsed, to an integer or a
+///               string by kind
+///   assign_or   ArgParser::assign_or of every key of the same values
+///               parsed, to an integer or a string
+///
+///   visit_bench [--perf] [--args N] [--iterations N]
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include <namedargs/parser.hpp>
+#include "bench.hpp"
+
+namespace na = namedargs;
+namespace nb = namedargs::bench;
+
+namespace {
+  struct sink {
+    std::uint64_t sum = 0;
+    sink& operator=(std::int64_t x) {
+      sum += static_cast<std::uint64_t>(x);
+      return *this;
+    }
+    sink& operator=(std::string_view x) {
+      sum += x.size();
+      return *this;
+    }
+  };
+
+  using std_value = std::variant<std::int64_t, std::string_view>;
+  using tagged = na::ArgParser::ArgType;
+} // namespace
+
+int main(int argc, char** argv) {
+  const nb::options opts = nb::parse_options(argc, argv);
+  std::vector<std_value> std_values;
+  std::vector<tagged> tagged_values;
+  std::string input;
+  std::vector<std::pair<std::string, bool>> keys; // Key, integer
+  std::uint32_t x = 12345;
+  for (std::size_t i = 0; i < opts.args; ++i) {
+    x = x * 1103515245 + 12345;
+    const bool is_int = (x >> 16 & 1) != 0;
+    std::string key = "k" + std::to_string(i);
+    input += (i == 0 ? "" : ", ") + key + " = ";
+    if (is_int) {
+      std_values.emplace_back(std::int64_t{x >> 8});
+      tagged_values.emplace_back(std::in_place_index<0>, std::int64_t{x >> 8});
+      input += std::to_string(x >> 8);
+    } else {
+      std_values.emplace_back(std::string_view("value"));
+      tagged_values.emplace_back(std::in_place_index<1>, "value");
+      input += "'value'";
+    }
+    keys.emplace_back(std::move(key), is_int);
+  }
+  na::ArgParser parser(input);
+  parser.execute();
+  const nb::workload w{input.size(), opts.args};
+
+  std::printf("# %zu values; sizeof: variant %zu, tagged_value %zu\n",
+              opts.args, sizeof(std_value), sizeof(tagged));
+  nb::runner runner(opts);
+  runner.run("std_visit", w, [&] {
+    sink s;
+    for (const auto& v : std_values)
+      std::visit([&s](const auto& a) { s = a; }, v);
+    nb::do_not_optimize(s.sum);
+  });
+  runner.run("tagged", w, [&] {
+    sink s;
+    for (const auto& v : tagged_values)
+      na::visit([&s](const auto& a) { s = a; }, v);
+    nb::do_not_optimize(s.sum);
+  });
+  runner.run("assign_arg", w, [&] {
+    std::int64_t num = 0;
+    std::string_view str;
+    std::uint64_t sum = 0;
+    for (const auto& [key, value] : parser.args())
+      sum += value.index() == 0
+               ? static_cast<std::uint64_t>(na::assign_arg(num, value))
+               : na::assign_arg(str, value).size();
+    nb::do_not_optimize(sum);
+  });
+  runner.run("assign_or", w, [&] {
+    std::int64_t num = 0;
+    std::string_view str;
+    std::uint64_t sum = 0;
+    for (const auto& [key, is_int] : keys)
+      sum += is_int ? static_cast<std::uint64_t>(parser.assign_or(num, key, 0))
+                    : parser.assign_or(str, key, "").size();
+    nb::do_not_optimize(sum);
+  });
+}
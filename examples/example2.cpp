@@ -0,0 +1,28 @@
+#include <iostream>
+#include <namedargs/convert.hpp>
+
+namespace na = namedargs;
+
+struct params {
+  int num;
+  std::string_view str;
+};
+
+template <>
+struct na::ArgParserTraits<params> {
+  static constexpr auto fields = std::tuple{
+    na::field("num", &params::num, 0),
+    na::field("str", &params::str, ""),
+  };
+  static constexpr params convert(const na::ArgParser& p) {
+    return na::convert_fields<params, fields>(p);
+  }
+};
+
+int main() {
+  constexpr params p =
+    na::parse_args<params>("num = 42, str = 'Hello, world!'");
+
+  std::cout << "num: " << p.num << std::endl; // → num: 42
+  std::cout << "str: " << p.str << std::endl; // → str: Hello, world!
+}
@@ -0,0 +1,14 @@
+/// @file check.hpp
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+
+// Aborts with the failed condition, so that libFuzzer saves the input
+#define NAMEDARGS_FUZZ_CHECK(cond)                                           \
+  ((cond) ? void() : namedargs_fuzz_failure(#cond, __FILE__, __LINE__))
+
+[[noreturn]] inline void namedargs_fuzz_failure(const char* cond,
+                                                const char* file, int line) {
+  std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, cond);
+  std::abort();
+}
@@ -0,0 +1,41 @@
+/// @file driver.cpp
+/// Replays corpus files and directories through `LLVMFuzzerTestOneInput`
+/// when libFuzzer is not available (e.g. with GCC). Options starting with
+/// '-' are ignored, so the command lines of libFuzzer runs can be reused.
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t size);
+
+namespace {
+  void run_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(in)),
+                                  std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(bytes.data()),
+                           bytes.size());
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count = 0;
+  for (int i = 1; i < argc; ++i) {
+    const std::filesystem::path arg = argv[i];
+    if (arg.string().starts_with('-'))
+      continue;
+    if (std::filesystem::is_directory(arg)) {
+      for (const auto& entry : std::filesystem::directory_iterator(arg))
+        if (entry.is_regular_file())
+          run_file(entry.path()), ++count;
+    } else
+      run_file(arg), ++count;
+  }
+  std::printf("%zu inputs passed\n", count);
+}
@@ -0,0 +1,55 @@
+/// @file from_chars.cpp
+/// Differential fuzzer of integer literals: `int_kind::scan` (digit span
+/// kernel plus unchecked conversion of up to 18 digits) must agree with
+/// `_Integer_from_chars` on the value, the length and whether it fails,
+/// at every scanning kernel level the CPU supports.
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <namedargs/from_chars.hpp>
+#include <namedargs/parser.hpp>
+#include "check.hpp"
+
+namespace na = namedargs;
+
+namespace {
+  struct scanned {
+    std::int64_t value;
+    std::size_t size;
+    bool operator==(const scanned&) const = default;
+  };
+
+  std::optional<scanned> scan(std::string_view sv) {
+    std::int64_t value{};
+    try {
+      const std::size_t size = na::int_kind::scan(sv, value, {});
+      return scanned{value, size};
+    } catch (const na::parse_error&) {
+      return std::nullopt;
+    }
+  }
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t size) {
+  const std::string_view sv(reinterpret_cast<const char*>(data), size);
+  if (sv.empty() or not na::isdigit(sv.front()))
+    return 0; // `int_kind` is only tried on a digit
+
+  std::int64_t value{};
+  const auto [ptr, ec] =
+    na::_Integer_from_chars(sv.data(), sv.data() + sv.size(), value, 10);
+  std::optional<scanned> reference;
+  if (ec == std::errc{})
+    reference = scanned{value, static_cast<std::size_t>(ptr - sv.data())};
+
+  const auto top = na::supported_simd_level();
+  for (unsigned l = 0; l <= static_cast<unsigned>(top); ++l) {
+    na::use_simd_level(static_cast<na::simd_level>(l));
+    NAMEDARGS_FUZZ_CHECK(scan(sv) == reference);
+  }
+  na::use_simd_level(top);
+  return 0;
+}
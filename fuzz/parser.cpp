@@ -0,0 +1,298 @@
+/// @file parser.cpp
+/// Differential fuzzer of the tokenizer and parser: each input is run with
+/// every scanning kernel level the CPU supports and must give the same
+/// tokens, arguments and errors as the scalar level, and as a byte-wise
+/// reference which shares none of the scanning code. `execute_recover()`
+/// must succeed exactly when `execute()` does, with the same arguments,
+/// and `execute_indexed()` and `execute_parallel()` must give the same
+/// arguments or error.
+#include <algorithm> // std::ranges::sort
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility> // std::in_place_index
+#include <vector>
+#include <namedargs/parser.hpp>
+#include "check.hpp"
+
+namespace na = namedargs;
+
+namespace {
+  using Token = na::ArgParser::Token;
+  using ArgType = na::ArgParser::ArgType;
+  using ArgList = std::vector<std::pair<std::string_view, ArgType>>;
+
+  // Reference of `ArgParser`, one byte at a time with the ctype predicates
+  // and `decode_utf8`: no span_class, start tables or value kinds
+
+  std::size_t reference_utf8_error(std::string_view sv) {
+    for (std::size_t i = 0; i < sv.size();) {
+      if (na::isascii(sv[i])) {
+        ++i;
+        continue;
+      }
+      const std::size_t size = na::decode_utf8(sv.substr(i)).size;
+      if (size == 0)
+        return i;
+      i += size;
+    }
+    return std::string_view::npos;
+  }
+
+  /// Length of the identifier at the head of `sv`, or 0
+  std::size_t reference_identifier(std::string_view sv,
+                                   na::ArgParserOptions options) {
+    std::size_t pos = 0;
+    if (na::isident1(sv[0])) {
+      pos = 1;
+    } else if (options.unicode_identifiers and not na::isascii(sv[0])) {
+      const auto [cp, size] = na::decode_utf8(sv);
+      if (size == 0 or not na::is_xid_start(cp))
+        return 0;
+      pos = size;
+    } else {
+      return 0;
+    }
+    while (pos < sv.size()) {
+      if (na::isident2(sv[pos])) {
+        ++pos;
+      } else if (options.unicode_identifiers and not na::isascii(sv[pos])) {
+        const auto [cp, size] = na::decode_utf8(sv.substr(pos));
+        if (size == 0 or not na::is_xid_continue(cp))
+          break;
+        pos += size;
+      } else {
+        break;
+      }
+    }
+    return pos;
+  }
+
+  std::string_view reference_token(std::string_view sv, Token& tok,
+                                   na::ArgParserOptions options) {
+    while (not sv.empty() and na::isspace(sv[0]))
+      sv.remove_prefix(1);
+    if (sv.empty()) {
+      tok = {na::TokenKind::eof, sv, {}};
+      return sv;
+    }
+    if (na::isdigit(sv[0])) {
+      std::size_t size = 0;
+      std::int64_t value = 0;
+      for (; size < sv.size() and na::isdigit(sv[size]); ++size)
+        if (__builtin_mul_overflow(value, 10, &value)
+            or __builtin_add_overflow(value, sv[size] - '0', &value))
+          throw na::parse_error("conversion from chars to integer failed",
+                                sv.data());
+      tok = {na::TokenKind::num, sv.substr(0, size),
+             ArgType(std::in_place_index<0>, value)};
+      return sv.substr(size);
+    }
+    if (sv[0] == '\'') {
+      const std::size_t close = sv.find('\'', 1);
+      if (close == std::string_view::npos)
+        throw na::parse_error("unclosed string literal", sv.data(), "'");
+      const std::string_view value = sv.substr(1, close - 1);
+      if (options.validate_utf8)
+        if (const std::size_t bad = reference_utf8_error(value);
+            bad != std::string_view::npos)
+          throw na::parse_error("invalid UTF-8 in string literal",
+                                value.data() + bad);
+      tok = {na::TokenKind::str, sv.substr(0, close + 1),
+             ArgType(std::in_place_index<1>, value)};
+      return sv.substr(close + 1);
+    }
+    if (const std::size_t size = reference_identifier(sv, options)) {
+      tok = {na::TokenKind::ident, sv.substr(0, size), {}};
+      return sv.substr(size);
+    }
+    if (na::ispunct(sv[0])) {
+      tok = {na::TokenKind::punct, sv.substr(0, 1), {}};
+      return sv.substr(1);
+    }
+    throw na::parse_error("unexpected character", sv.data());
+  }
+
+  /// Arguments of `tokens` sorted by key, or where `execute()` fails: the
+  /// first repeated key if one comes before the syntax error
+  std::pair<ArgList, const char*>
+  reference_parse(const std::vector<Token>& tokens) {
+    ArgList args;
+    std::vector<std::string_view> keys; // In input order
+    const char* syntax_error = nullptr;
+    auto is = [](const Token& tok, std::string_view punct) {
+      return tok.kind == na::TokenKind::punct and tok.sv == punct;
+    };
+    for (std::size_t i = 0; tokens[i].kind != na::TokenKind::eof;) {
+      if (tokens[i].kind != na::TokenKind::ident) {
+        syntax_error = tokens[i].sv.data();
+        break;
+      }
+      keys.push_back(tokens[i].sv);
+      if (not is(tokens[i + 1], "=")) {
+        syntax_error = tokens[i + 1].sv.data();
+        break;
+      }
+      const Token& value = tokens[i + 2];
+      if (value.kind != na::TokenKind::num
+          and value.kind != na::TokenKind::str) {
+        syntax_error = value.sv.data();
+        break;
+      }
+      args.push_back({tokens[i].sv, value.value});
+      i += 3;
+      if (tokens[i].kind == na::TokenKind::eof)
+        break;
+      if (not is(tokens[i], ",")) {
+        syntax_error = tokens[i].sv.data();
+        break;
+      }
+      ++i;
+    }
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      for (std::size_t j = 0; j < i; ++j)
+        if (keys[j] == keys[i])
+          return {{}, keys[i].data()};
+    if (syntax_error != nullptr)
+      return {{}, syntax_error};
+    std::ranges::sort(args, {}, [](const auto& arg) { return arg.first; });
+    return {args, nullptr};
+  }
+
+  struct outcome {
+    std::vector<Token> tokens;
+    std::string token_error; // Empty if tokenized up to eof
+    const char* token_error_at = nullptr;
+    ArgList args;
+    std::string error; // Empty if `execute()` succeeded
+    std::size_t error_offset = std::string_view::npos;
+
+    bool operator==(const outcome& other) const {
+      auto same = [](const auto& x, const auto& y) {
+        // Pointer equality: tokens must refer to the same bytes
+        return x.kind == y.kind and x.sv.data() == y.sv.data()
+               and x.sv.size() == y.sv.size() and x.value == y.value;
+      };
+      return std::equal(tokens.begin(), tokens.end(), other.tokens.begin(),
+                        other.tokens.end(), same)
+             and token_error == other.token_error
+             and token_error_at == other.token_error_at and args == other.args
+             and error == other.error and error_offset == other.error_offset;
+    }
+  };
+
+  outcome run_reference(std::string_view input,
+                        na::ArgParserOptions options) {
+    outcome out;
+    try {
+      std::string_view sv = input;
+      Token tok{};
+      do {
+        sv = reference_token(sv, tok, options);
+        out.tokens.push_back(tok);
+      } while (tok.kind != na::TokenKind::eof);
+    } catch (const na::parse_error& e) {
+      out.token_error = e.what();
+      out.token_error_at = e.where();
+      out.error = e.what();
+      out.error_offset = static_cast<std::size_t>(e.where() - input.data());
+      return out;
+    }
+    const auto [args, error_at] = reference_parse(out.tokens);
+    out.args = args;
+    if (error_at != nullptr) {
+      out.error = "error";
+      out.error_offset = static_cast<std::size_t>(error_at - input.data());
+    }
+    return out;
+  }
+
+  /// Checks `out` against the reference: the same tokens, arguments and
+  /// error positions. Only the tokenizer's error messages are compared,
+  /// the parser's are formatted with the input.
+  void check_reference(const outcome& out, const outcome& reference) {
+    NAMEDARGS_FUZZ_CHECK(std::ranges::equal(
+      out.tokens, reference.tokens, [](const Token& x, const Token& y) {
+        return x.kind == y.kind and x.sv.data() == y.sv.data()
+               and x.sv.size() == y.sv.size() and x.value == y.value;
+      }));
+    NAMEDARGS_FUZZ_CHECK(out.token_error == reference.token_error);
+    NAMEDARGS_FUZZ_CHECK(out.token_error_at == reference.token_error_at);
+    NAMEDARGS_FUZZ_CHECK(out.args == reference.args);
+    NAMEDARGS_FUZZ_CHECK(out.error.empty() == reference.error.empty());
+    NAMEDARGS_FUZZ_CHECK(out.error_offset == reference.error_offset);
+  }
+
+  outcome run(std::string_view input, na::ArgParserOptions options) {
+    outcome out;
+    try {
+      std::string_view sv = input;
+      Token tok{};
+      do {
+        sv = na::ArgParser::next_token(sv, tok, options);
+        out.tokens.push_back(tok);
+      } while (tok.kind != na::TokenKind::eof);
+    } catch (const na::parse_error& e) {
+      out.token_error = e.what();
+      out.token_error_at = e.where();
+    }
+
+    na::ArgParser parser(input, options);
+    try {
+      parser.execute();
+      out.args.assign(parser.args().begin(), parser.args().end());
+    } catch (const na::parse_error& e) {
+      out.error = e.what();
+      out.error_offset = e.offset();
+    }
+
+    na::ArgParser indexed(input, options);
+    try {
+      indexed.execute_indexed();
+      NAMEDARGS_FUZZ_CHECK(out.error.empty());
+      NAMEDARGS_FUZZ_CHECK(std::ranges::equal(indexed.args(), out.args));
+    } catch (const na::parse_error& e) {
+      NAMEDARGS_FUZZ_CHECK(out.error == e.what());
+    }
+
+    for (unsigned threads = 2; threads <= 5; ++threads) {
+      na::ArgParser parallel(input, options);
+      try {
+        parallel.execute_parallel(threads);
+        NAMEDARGS_FUZZ_CHECK(out.error.empty());
+        NAMEDARGS_FUZZ_CHECK(std::ranges::equal(parallel.args(), out.args));
+      } catch (const na::parse_error& e) {
+        NAMEDARGS_FUZZ_CHECK(out.error == e.what());
+      }
+    }
+
+    na::ArgParser recovering(input, options);
+    na::error_buffer errors;
+    const bool ok = recovering.execute_recover(errors);
+    NAMEDARGS_FUZZ_CHECK(ok == out.error.empty());
+    NAMEDARGS_FUZZ_CHECK(ok == errors.empty());
+    if (ok)
+      NAMEDARGS_FUZZ_CHECK(std::ranges::equal(recovering.args(), out.args));
+    return out;
+  }
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t size) {
+  const std::string_view input(reinterpret_cast<const char*>(data), size);
+  const auto top = na::supported_simd_level();
+  for (const bool validate_utf8 : {true, false})
+    for (const bool unicode_identifiers : {false, true}) {
+      const na::ArgParserOptions options{validate_utf8, unicode_identifiers};
+      na::use_simd_level(na::simd_level::scalar);
+      const outcome scalar = run(input, options);
+      check_reference(scalar, run_reference(input, options));
+      for (unsigned l = 1; l <= static_cast<unsigned>(top); ++l) {
+        na::use_simd_level(static_cast<na::simd_level>(l));
+        NAMEDARGS_FUZZ_CHECK(run(input, options) == scalar);
+      }
+    }
+  na::use_simd_level(top);
+  return 0;
+}
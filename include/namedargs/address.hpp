@@ -0,0 +1,199 @@
+/// @file address.hpp
+#pragma once
+#include <array>
+#include <bit> // std::countr_zero
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <string_view>
+#include <namedargs/ctype.hpp>
+#include <namedargs/from_chars.hpp>
+#include <namedargs/parser.hpp>
+#include <namedargs/swar.hpp>
+#if __has_include(<netinet/in.h>)
+#include <netinet/in.h>
+#define NAMEDARGS_HAS_NETINET 1
+#endif
+
+namespace namedargs {
+  /// IPv4 or IPv6 address with an optional CIDR prefix length or port
+  struct ip_address {
+    enum class family_type : std::uint8_t { v4, v6 };
+    static constexpr std::uint8_t no_prefix = 0xFF;
+
+    std::array<std::uint8_t, 16> bytes{}; // Network order; IPv4 uses 4 bytes
+    family_type family = family_type::v4;
+    std::uint8_t prefix = no_prefix; // CIDR prefix length
+    std::uint16_t port = 0;          // 0 if not given
+
+    constexpr bool operator==(const ip_address&) const = default;
+
+#ifdef NAMEDARGS_HAS_NETINET
+    operator in_addr() const {
+      if (family != family_type::v4)
+        throw parse_error("IPv6 address is not assignable to in_addr");
+      in_addr a{};
+      std::memcpy(&a.s_addr, bytes.data(), 4);
+      return a;
+    }
+
+    operator in6_addr() const {
+      if (family != family_type::v6)
+        throw parse_error("IPv4 address is not assignable to in6_addr");
+      in6_addr a{};
+      std::memcpy(a.s6_addr, bytes.data(), 16);
+      return a;
+    }
+#endif
+  };
+
+  /// Parses a dotted quad at the head of `sv` into `out`. Digits and dots of
+  /// the first 16 bytes are classified 8 bytes at a time; returns the length
+  /// of the literal, or 0 if `sv` does not start with one.
+  constexpr std::size_t parse_ipv4(std::string_view sv,
+                                   std::uint8_t* out) noexcept {
+    char buf[16]{};
+    for (std::size_t i = 0; i < std::min(sv.size(), sizeof(buf)); ++i)
+      buf[i] = sv[i];
+    std::uint64_t dots[2], digits[2];
+    for (std::size_t w = 0; w < 2; ++w) {
+      const std::uint64_t x = load_u64(buf + 8 * w);
+      dots[w] = swar_eq(x, '.');
+      digits[w] = swar_digit(x);
+    }
+    // Length of the run of digits and dots
+    std::size_t size = 0;
+    for (std::size_t w = 0; w < 2; ++w) {
+      const std::uint64_t other = ~(dots[w] | digits[w]) & swar_high;
+      if (other != 0) {
+        size += icast<std::size_t>(std::countr_zero(other)) / 8;
+        break;
+      }
+      size += 8;
+    }
+    if (size < 7 or 15 < size)
+      return 0;
+
+    std::size_t pos = 0;
+    for (std::size_t n = 0; n < 4; ++n) {
+      unsigned value = 0;
+      std::size_t len = 0;
+      for (; pos < size and buf[pos] != '.'; ++pos, ++len)
+        value = value * 10 + static_cast<unsigned>(buf[pos] - '0');
+      if (len == 0 or 3 < len or 255 < value or (len > 1 and value < 10)
+          or (len > 2 and value < 100))
+        return 0; // Empty, too long, out of range or with leading zeros
+      out[n] = static_cast<std::uint8_t>(value);
+      if (n < 3 and (pos == size or buf[pos++] != '.'))
+        return 0;
+    }
+    return pos == size ? size : 0;
+  }
+
+  /// Parses an IPv6 address (RFC 4291 text form, optionally ending with a
+  /// dotted quad) at the head of `sv`; returns its length or 0
+  constexpr std::size_t parse_ipv6(std::string_view sv,
+                                   std::uint8_t* out) noexcept {
+    std::array<std::uint16_t, 8> groups{};
+    std::size_t n = 0, gap = 8, i = 0;
+    bool has_gap = false;
+    if (sv.starts_with("::")) {
+      has_gap = true;
+      gap = 0;
+      i = 2;
+    }
+    while (n < 8 and i < sv.size() and _Digit_from_char(sv[i]) < 16) {
+      std::size_t len = 0;
+      unsigned value = 0;
+      for (; len < 5 and i + len < sv.size()
+             and _Digit_from_char(sv[i + len]) < 16;
+           ++len)
+        value = value * 16 + _Digit_from_char(sv[i + len]);
+      if (i + len < sv.size() and sv[i + len] == '.') {
+        // Trailing dotted quad
+        std::uint8_t v4[4]{};
+        const std::size_t size = parse_ipv4(sv.substr(i), v4);
+        if (size == 0 or 6 < n)
+          return 0;
+        groups[n++] = static_cast<std::uint16_t>(v4[0] << 8 | v4[1]);
+        groups[n++] = static_cast<std::uint16_t>(v4[2] << 8 | v4[3]);
+        i += size;
+        break;
+      }
+      if (4 < len)
+        return 0;
+      groups[n++] = static_cast<std::uint16_t>(value);
+      i += len;
+      if (sv.substr(i).starts_with("::")) {
+        if (has_gap)
+          return 0;
+        has_gap = true;
+        gap = n;
+        i += 2;
+      } else if (i < sv.size() and sv[i] == ':') {
+        if (i + 1 == sv.size() or _Digit_from_char(sv[i + 1]) >= 16)
+          return 0;
+        ++i;
+      } else
+        break;
+    }
+    if (has_gap ? 7 < n : n != 8)
+      return 0;
+    const std::size_t zeros = 8 - n;
+    for (std::size_t k = 0, g = 0; k < 8; ++k) {
+      const std::uint16_t v = (gap <= k and k < gap + zeros) ? 0 : groups[g++];
+      out[2 * k] = static_cast<std::uint8_t>(v >> 8);
+      out[2 * k + 1] = static_cast<std::uint8_t>(v & 0xFF);
+    }
+    return i;
+  }
+
+  /// Address literals: `10.0.0.1`, `10.0.0.1:8080`, `192.168.0.0/16`,
+  /// `::1`, `[::1]:53`, `2001:db8::/32`. Tried before `int_kind`, so that
+  /// the digits, `.` and `:` of an address are kept in one token.
+  struct address_kind {
+    using value_type = ip_address;
+
+    static constexpr bool first(char c) {
+      return _Digit_from_char(c) < 16 or c == ':' or c == '[';
+    }
+
+    static constexpr std::size_t
+    scan(std::string_view sv, ip_address& out, const ArgParserOptions&) {
+      std::size_t size = 0;
+      bool bracketed = false;
+      if (sv.starts_with('[')) {
+        size = parse_ipv6(sv.substr(1), out.bytes.data());
+        if (size == 0 or sv.substr(1 + size, 1) != "]")
+          return 0;
+        size += 2;
+        bracketed = true;
+        out.family = ip_address::family_type::v6;
+      } else if ((size = parse_ipv4(sv, out.bytes.data())) != 0) {
+        // IPv4 takes precedence over IPv6 ending with a dotted quad
+        out.family = ip_address::family_type::v4;
+      } else if ((size = parse_ipv6(sv, out.bytes.data())) != 0) {
+        out.family = ip_address::family_type::v6;
+      } else
+        return 0;
+
+      const bool v4 = out.family == ip_address::family_type::v4;
+      auto number = [&sv, &size](std::uint64_t max) -> std::uint64_t {
+        std::uint64_t value{};
+        const char* first = sv.data() + size + 1;
+        auto [ptr, ec] = from_chars(first, sv.data() + sv.size(), value);
+        if (ec != std::errc{} or max < value)
+          throw parse_error("invalid address suffix", first);
+        size = icast<std::size_t>(ptr - sv.data());
+        return value;
+      };
+      if (sv.substr(size).starts_with('/') and not bracketed)
+        out.prefix = static_cast<std::uint8_t>(number(v4 ? 32 : 128));
+      else if (sv.substr(size).starts_with(':') and (v4 or bracketed))
+        out.port = static_cast<std::uint16_t>(number(65535));
+      if (size < sv.size() and isident2(sv[size]))
+        return 0; // e.g. the identifier `fe80abc`
+      return size;
+    }
+  };
+} // namespace namedargs
@@ -0,0 +1,180 @@
+/// @file aggregate.hpp
+#pragma once
+#include <algorithm> // std::ranges::count, std::ranges::copy, std::min
+#include <array>
+#include <cstddef> // std::size_t
+#include <string_view>
+#include <tuple>       // std::tie, std::get
+#include <type_traits> // std::is_aggregate_v
+#include <utility>     // std::index_sequence
+#include <namedargs/convert.hpp>
+#include <namedargs/ctype.hpp>
+#include <namedargs/parser.hpp>
+
+namespace namedargs {
+  /// Maximum number of fields `tie_fields` supports
+  inline constexpr std::size_t max_aggregate_arity = 16;
+
+  // Converts to anything; used only in unevaluated contexts
+  struct any_initializer {
+    template <class T>
+    constexpr operator T() const noexcept;
+  };
+
+  template <class T, std::size_t... I>
+  constexpr bool brace_initializable_with(std::index_sequence<I...>) {
+    return requires { T{((void)I, any_initializer{})...}; };
+  }
+
+  /// Number of fields of the aggregate `T`. Fields which are aggregates
+  /// themselves may be counted by brace elision; such types must be named
+  /// explicitly with a matching number of names.
+  template <class T, std::size_t N = 0>
+  constexpr std::size_t aggregate_arity() {
+    static_assert(std::is_aggregate_v<T>);
+    if constexpr (N < max_aggregate_arity
+                  and brace_initializable_with<T>(
+                    std::make_index_sequence<N + 1>{}))
+      return aggregate_arity<T, N + 1>();
+    else
+      return N;
+  }
+
+  /// Tuple of references to the fields of `t`, bound via structured bindings
+  template <class T>
+  constexpr auto tie_fields(T& t) {
+    constexpr std::size_t N = aggregate_arity<T>();
+    static_assert(0 < N and N <= max_aggregate_arity);
+    // clang-format off
+    if constexpr (N == 1) {
+      auto& [x0] = t;
+      return std::tie(x0);
+    }
+    else if constexpr (N == 2) {
+      auto& [x0, x1] = t;
+      return std::tie(x0, x1);
+    }
+    else if constexpr (N == 3) {
+      auto& [x0, x1, x2] = t;
+      return std::tie(x0, x1, x2);
+    }
+    else if constexpr (N == 4) {
+      auto& [x0, x1, x2, x3] = t;
+      return std::tie(x0, x1, x2, x3);
+    }
+    else if constexpr (N == 5) {
+      auto& [x0, x1, x2, x3, x4] = t;
+      return std::tie(x0, x1, x2, x3, x4);
+    }
+    else if constexpr (N == 6) {
+      auto& [x0, x1, x2, x3, x4, x5] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5);
+    }
+    else if constexpr (N == 7) {
+      auto& [x0, x1, x2, x3, x4, x5, x6] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6);
+    }
+    else if constexpr (N == 8) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7);
+    }
+    else if constexpr (N == 9) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7, x8] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7, x8);
+    }
+    else if constexpr (N == 10) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7, x8, x9] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9);
+    }
+    else if constexpr (N == 11) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10);
+    }
+    else if constexpr (N == 12) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11);
+    }
+    else if constexpr (N == 13) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12);
+    }
+    else if constexpr (N == 14) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13);
+    }
+    else if constexpr (N == 15) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14);
+    }
+    else if constexpr (N == 16) {
+      auto& [x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15] = t;
+      return std::tie(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
+    }
+    // clang-format on
+  }
+
+  /// Number of comma-separated names in `sv`
+  constexpr std::size_t count_field_names(std::string_view sv) {
+    return static_cast<std::size_t>(std::ranges::count(sv, ',')) + 1;
+  }
+
+  /// Splits "a, b, c" into {"a", "b", "c"}
+  template <std::size_t N>
+  constexpr std::array<std::string_view, N>
+  split_field_names(std::string_view sv) {
+    std::array<std::string_view, N> names{};
+    for (auto& name : names) {
+      const std::size_t pos = std::min(sv.find(','), sv.size());
+      name = sv.substr(0, pos);
+      while (not name.empty() and namedargs::isspace(name.front()))
+        name.remove_prefix(1);
+      while (not name.empty() and namedargs::isspace(name.back()))
+        name.remove_suffix(1);
+      sv = sv.substr(std::min(pos + 1, sv.size()));
+    }
+    return names;
+  }
+
+  /// Converts parsed arguments to the aggregate `T` whose fields are named by
+  /// `Names` in declaration order. Fields not given keep their default member
+  /// initializers. The sorted arguments are walked once, merge-joined against
+  /// the names sorted at compile time.
+  template <class T, const auto& Names, class Parser>
+  constexpr T convert_aggregate(const Parser& p) {
+    constexpr std::size_t N = std::size(Names);
+    static_assert(aggregate_arity<T>() == N,
+                  "the number of names must match the number of fields");
+    constexpr std::array<std::string_view, N> keys = [] {
+      std::array<std::string_view, N> a{};
+      std::ranges::copy(Names, a.begin());
+      return a;
+    }();
+    constexpr auto order = sorted_order(keys);
+
+    T result{};
+    auto fields = tie_fields(result);
+    merge_join(
+      p.args(), keys, order,
+      [&fields](std::size_t i, const auto& arg) {
+        with_index<N>(i, [&](auto I) {
+          assign_arg(std::get<I>(fields), arg.second);
+        });
+      },
+      [](std::string_view) {});
+    return result;
+  }
+} // namespace namedargs
+
+/// Generates `ArgParserTraits<T>` for the aggregate `T` from its field names,
+/// e.g. `NAMEDARGS_AGGREGATE(params, num, str);`
+#define NAMEDARGS_AGGREGATE(T, ...)                                         \
+  template <>                                                                \
+  struct namedargs::ArgParserTraits<T> {                                     \
+    static constexpr auto names =                                            \
+      namedargs::split_field_names<namedargs::count_field_names(             \
+        #__VA_ARGS__)>(#__VA_ARGS__);                                        \
+    template <class Parser>                                                  \
+    static constexpr T convert(const Parser& p) {                            \
+      return namedargs::convert_aggregate<T, names>(p);                      \
+    }                                                                        \
+  }
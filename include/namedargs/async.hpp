@@ -0,0 +1,177 @@
+/// @file async.hpp
+#pragma once
+#include <algorithm> // std::max
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <deque>
+#include <exception>  // std::exception_ptr
+#include <functional> // std::function
+#include <future>
+#include <memory> // std::make_shared, std::unique_ptr
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility> // std::move, std::declval
+#include <vector>
+#include <namedargs/parser.hpp>
+
+namespace namedargs {
+  /// Runs `f()` where it is given: an executor is any type with
+  /// `execute(std::function<void()>)`. `execute` should not throw: in a task
+  /// of `thread_pool` the exception is dropped.
+  template <class E>
+  concept executor = requires(E& e, std::function<void()> f) {
+    e.execute(std::move(f));
+  };
+
+  /// Runs tasks immediately on the calling thread
+  struct inline_executor {
+    void execute(std::function<void()> f) const { f(); }
+  };
+
+  /// Work-stealing thread pool. Each worker has a queue: a task submitted
+  /// from a worker goes to its own queue, others are spread round-robin.
+  /// A worker takes the newest task of its queue, or else steals the oldest
+  /// one of another queue. An exception thrown by a task is dropped. The
+  /// destructor runs the tasks already submitted, then joins the workers.
+  class thread_pool {
+  public:
+    explicit thread_pool(
+      unsigned threads = std::thread::hardware_concurrency())
+      : queues_(std::max(threads, 1u)) {
+      for (auto& q : queues_)
+        q = std::make_unique<queue>();
+      workers_.reserve(queues_.size());
+      for (std::size_t i = 0; i < queues_.size(); ++i)
+        workers_.emplace_back([this, i] { run(i); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool() {
+      {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+      }
+      ready_.notify_all();
+      for (auto& worker : workers_)
+        worker.join();
+    }
+
+    std::size_t size() const noexcept { return workers_.size(); }
+
+    void execute(std::function<void()> f) {
+      const std::size_t i =
+        current_ == this ? index_ : next_.fetch_add(1) % queues_.size();
+      {
+        std::lock_guard lock(queues_[i]->mutex);
+        queues_[i]->tasks.push_back(std::move(f));
+      }
+      {
+        std::lock_guard lock(mutex_);
+        ++pending_;
+      }
+      ready_.notify_one();
+    }
+
+  private:
+    struct queue {
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+    };
+
+    void run(std::size_t i) {
+      current_ = this;
+      index_ = i;
+      for (;;) {
+        {
+          std::unique_lock lock(mutex_);
+          ready_.wait(lock, [this] { return stop_ or pending_ != 0; });
+          if (pending_ == 0)
+            return;
+          // Claims one of the queued tasks
+          --pending_;
+        }
+        std::function<void()> task;
+        while (not try_pop(i, task))
+          std::this_thread::yield();
+        try {
+          task();
+        } catch (...) {
+          // Nobody to report it to: the worker goes on
+        }
+      }
+    }
+
+    bool try_pop(std::size_t i, std::function<void()>& task) {
+      for (std::size_t k = 0; k < queues_.size(); ++k) {
+        queue& q = *queues_[(i + k) % queues_.size()];
+        std::lock_guard lock(q.mutex);
+        if (q.tasks.empty())
+          continue;
+        if (k == 0) {
+          task = std::move(q.tasks.back());
+          q.tasks.pop_back();
+        } else {
+          task = std::move(q.tasks.front());
+          q.tasks.pop_front();
+        }
+        return true;
+      }
+      return false;
+    }
+
+    std::vector<std::unique_ptr<queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::size_t pending_ = 0; // Tasks queued and not claimed
+    bool stop_ = false;
+    std::atomic<std::size_t> next_{0};
+    static inline thread_local const thread_pool* current_ = nullptr;
+    static inline thread_local std::size_t index_ = 0;
+  };
+
+  /// The pool of `parse_args_async`, one worker per core
+  inline thread_pool& default_thread_pool() {
+    static thread_pool pool;
+    return pool;
+  }
+
+  /// `parse_args<T, Parser>(sv)` on `pool`, with the parsers of each worker
+  /// reused through `parser_pool`. The future is made ready by a task run on
+  /// `ex`; if `ex.execute` throws instead, the future reports a broken
+  /// promise. `sv` must outlive the parse.
+  template <class T, class Parser = ArgParser,
+            executor Executor = inline_executor>
+  auto parse_args_async(std::string_view sv, Executor ex = {},
+                        thread_pool& pool = default_thread_pool())
+    -> std::future<decltype(ArgParserTraits<T>::convert(
+      std::declval<Parser>()))> {
+    using R = decltype(ArgParserTraits<T>::convert(std::declval<Parser>()));
+    struct state {
+      std::promise<R> promise;
+      std::optional<R> result;
+      std::exception_ptr error;
+    };
+    auto s = std::make_shared<state>();
+    auto future = s->promise.get_future();
+    pool.execute([sv, s, ex = std::move(ex)]() mutable {
+      try {
+        s->result.emplace(parse_args_pooled<T, Parser>(sv));
+      } catch (...) {
+        s->error = std::current_exception();
+      }
+      ex.execute([s] {
+        if (s->error)
+          s->promise.set_exception(s->error);
+        else
+          s->promise.set_value(std::move(*s->result));
+      });
+    });
+    return future;
+  }
+} // namespace namedargs
@@ -0,0 +1,303 @@
+/// @file convert.hpp
+#pragma once
+#include <algorithm> // std::sort, std::adjacent_find
+#include <array>
+#include <bit>     // std::countr_zero
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <numeric> // std::iota
+#include <string>
+#include <string_view>
+#include <tuple>       // std::tuple_size_v, std::get, std::apply
+#include <type_traits> // std::integral_constant, std::decay_t
+#include <utility>     // std::index_sequence
+#include <namedargs/parser.hpp>
+
+namespace namedargs {
+  /// Indices of `keys` in ascending key order
+  template <std::size_t N>
+  constexpr std::array<std::size_t, N>
+  sorted_order(const std::array<std::string_view, N>& keys) {
+    std::array<std::size_t, N> order{};
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [&keys](auto x, auto y) {
+      return keys[x] < keys[y];
+    });
+    if (std::adjacent_find(order.begin(), order.end(), [&keys](auto x, auto y) {
+          return keys[x] == keys[y];
+        }) != order.end())
+      throw parse_error("duplicate field name");
+    return order;
+  }
+
+  /// Invokes `f(std::integral_constant<std::size_t, i>{})` for runtime `i < N`
+  template <std::size_t N, class F>
+  constexpr void with_index(std::size_t i, F&& f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      ((i == I ? (f(std::integral_constant<std::size_t, I>{}), true) : false)
+       or ...);
+    }(std::make_index_sequence<N>{});
+  }
+
+  /// Walks the sorted `args` and the sorted `keys` once. Calls
+  /// `match(index of key, argument)` for each key found in `args` and
+  /// `unknown(key)` for each argument no key consumes.
+  template <std::size_t N, class Args, class Match, class Unknown>
+  constexpr void merge_join(const Args& args,
+                            const std::array<std::string_view, N>& keys,
+                            const std::array<std::size_t, N>& order,
+                            Match match, Unknown unknown) {
+    auto it = args.begin();
+    std::size_t j = 0;
+    while (it != args.end() and j < N) {
+      const std::string_view key = keys[order[j]];
+      if (it->first < key)
+        unknown(it++->first);
+      else if (key < it->first)
+        ++j;
+      else
+        match(order[j++], *it++);
+    }
+    for (; it != args.end(); ++it)
+      unknown(it->first);
+  }
+
+  /// Describes a field: the key, the member it is assigned to and the value
+  /// used when the key is not given
+  template <class T, class M, class D>
+  struct field_descriptor {
+    using class_type = T;
+    std::string_view key;
+    M T::*member;
+    D default_value;
+  };
+
+  template <class T, class M, class D>
+  constexpr field_descriptor<T, M, std::decay_t<D>>
+  field(std::string_view key, M T::*member, D&& default_value) {
+    return {key, member, std::forward<D>(default_value)};
+  }
+
+  /// Default value of a field which must be given
+  struct required_t {};
+
+  template <class T, class M>
+  constexpr field_descriptor<T, M, required_t> //
+  required(std::string_view key, M T::*member) {
+    return {key, member, {}};
+  }
+
+  /// Bit `i` is set if the `i`-th field is required
+  template <class Fields>
+  constexpr std::uint64_t required_mask(const Fields& fields) {
+    return std::apply(
+      [](const auto&... f) {
+        std::uint64_t mask = 0, bit = 1;
+        ((mask |= std::is_same_v<decltype(f.default_value), required_t>
+                    ? bit
+                    : 0,
+          bit <<= 1),
+         ...);
+        return mask;
+      },
+      fields);
+  }
+
+  template <class T, class F>
+  constexpr void assign_default(T& out, const F& f) {
+    if constexpr (not std::is_same_v<decltype(f.default_value), required_t>)
+      out.*f.member = f.default_value;
+  }
+
+  /// Unknown-key handler of `convert_fields` which ignores them
+  struct ignore_unknown {
+    constexpr void operator()(std::string_view) const noexcept {}
+  };
+
+  /// Unknown-key handler of `convert_fields` which throws `key_error`
+  struct reject_unknown {
+    void operator()(std::string_view key) const {
+      throw key_error(key_error::kind_type::unknown, key);
+    }
+  };
+
+  /// Keys of a tuple of field descriptors, in declaration order
+  template <class Fields>
+  constexpr auto field_keys(const Fields& fields) {
+    return std::apply(
+      [](const auto&... f) {
+        return std::array<std::string_view, sizeof...(f)>{f.key...};
+      },
+      fields);
+  }
+
+  /// Converts parsed arguments to `T` as described by `Fields`, a tuple of
+  /// `field_descriptor`s. The keys are sorted at compile time and merge-joined
+  /// against the sorted arguments in a single pass; arguments no field
+  /// consumes are passed to `unknown` (`reject_unknown` makes it strict).
+  /// Throws `key_error` if a `required` field is not given.
+  template <class T, const auto& Fields, class Parser,
+            class Unknown = ignore_unknown>
+  constexpr T convert_fields(const Parser& p, Unknown unknown = {}) {
+    constexpr std::size_t N =
+      std::tuple_size_v<std::remove_cvref_t<decltype(Fields)>>;
+    static_assert(N <= 64, "too many fields");
+    constexpr auto keys = field_keys(Fields);
+    constexpr auto order = sorted_order(keys);
+    constexpr std::uint64_t required = required_mask(Fields);
+
+    T result{};
+    std::uint64_t given = 0;
+    merge_join(
+      p.args(), keys, order,
+      [&result, &given](std::size_t i, const auto& arg) {
+        given |= std::uint64_t{1} << i;
+        with_index<N>(i, [&](auto I) {
+          assign_arg(result.*std::get<I>(Fields).member, arg.second);
+        });
+      },
+      unknown);
+    if (const std::uint64_t missing = required & ~given; missing != 0)
+      throw key_error(key_error::kind_type::missing,
+                      keys[icast<std::size_t>(std::countr_zero(missing))]);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (((given >> I & 1) == 0 ? assign_default(result, std::get<I>(Fields))
+                              : void()),
+       ...);
+    }(std::make_index_sequence<N>{});
+    return result;
+  }
+
+  /// Like `convert_fields`, but records type mismatches, missing required
+  /// fields and (with `reject_unknown`) unknown keys in `errors` instead of
+  /// stopping at the first one
+  template <class T, const auto& Fields, class Parser,
+            class Unknown = ignore_unknown>
+  T convert_fields_recover(const Parser& p, error_buffer& errors,
+                           Unknown unknown = {}) {
+    constexpr std::size_t N =
+      std::tuple_size_v<std::remove_cvref_t<decltype(Fields)>>;
+    static_assert(N <= 64, "too many fields");
+    constexpr auto keys = field_keys(Fields);
+    constexpr auto order = sorted_order(keys);
+    constexpr std::uint64_t required = required_mask(Fields);
+
+    auto push = [&errors, &p](const char* msg, std::string_view key) {
+      parse_error e(msg, key.data());
+      e.set_input(p.input());
+      errors.push(e);
+    };
+    T result{};
+    std::uint64_t given = 0;
+    merge_join(
+      p.args(), keys, order,
+      [&](std::size_t i, const auto& arg) {
+        given |= std::uint64_t{1} << i;
+        with_index<N>(i, [&](auto I) {
+          try {
+            assign_arg(result.*std::get<I>(Fields).member, arg.second);
+          } catch (const parse_error& e) {
+            push(e.what(), arg.first);
+          }
+        });
+      },
+      [&](std::string_view key) {
+        try {
+          unknown(key);
+        } catch (const key_error& e) {
+          push(e.what(), key);
+        }
+      });
+    for (std::uint64_t missing = required & ~given; missing != 0;
+         missing &= missing - 1)
+      errors.push(parse_error(
+        "missing required argument: "
+        + std::string(keys[icast<std::size_t>(std::countr_zero(missing))])));
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (((given >> I & 1) == 0 ? assign_default(result, std::get<I>(Fields))
+                              : void()),
+       ...);
+    }(std::make_index_sequence<N>{});
+    return result;
+  }
+
+  /// Parses `input` and writes each value straight into the field its key
+  /// names, without building tokens or arguments. Duplicate fields are caught
+  /// by a per-field seen bit; duplicate unknown keys are not detected.
+  template <class T, const auto& Fields, class Parser = ArgParser,
+            class Unknown = ignore_unknown>
+  constexpr T parse_fields(std::string_view input, Unknown unknown = {},
+                           ArgParserOptions options = {}) {
+    constexpr std::size_t N =
+      std::tuple_size_v<std::remove_cvref_t<decltype(Fields)>>;
+    static_assert(N <= 64, "too many fields");
+    constexpr auto keys = field_keys(Fields);
+    constexpr auto order = sorted_order(keys);
+    constexpr std::uint64_t required = required_mask(Fields);
+
+    T result{};
+    std::uint64_t given = 0;
+    typename Parser::Token tok{};
+    auto next = [&tok, &options, sv = input]() mutable {
+      sv = Parser::next_token(sv, tok, options);
+      return std::span(&tok, 1);
+    };
+
+    // args = stmt?
+    // stmt = assign ("," assign)*
+    // assign = ident "=" primary
+    try {
+      if (next().front().kind != TokenKind::eof) {
+        for (;;) {
+          if (tok.kind != TokenKind::ident)
+            throw parse_error("unexpected token; expecting TokenKind::ident",
+                              tok.sv.data(), "identifier");
+          const std::string_view key = tok.sv;
+          expect_punct("=", next());
+          next();
+          const auto it = std::ranges::lower_bound(
+            order, key, {}, [&keys](std::size_t i) { return keys[i]; });
+          if (it != order.end() and keys[*it] == key) {
+            const std::uint64_t bit = std::uint64_t{1} << *it;
+            if (given & bit)
+              throw parse_error("argument already exists", key.data());
+            given |= bit;
+            const auto arg = Parser::primary_value(tok);
+            with_index<N>(*it, [&](auto I) {
+              assign_arg(result.*std::get<I>(Fields).member, arg);
+            });
+          } else {
+            Parser::primary_value(tok);
+            unknown(key);
+          }
+          if (not consume_punct(",", next()))
+            break;
+          next();
+        }
+        if (tok.kind != TokenKind::eof)
+          throw parse_error("unexpected token", tok.sv.data(),
+                            "',' or end of input");
+      }
+    } catch (parse_error& e) {
+      e.set_input(input);
+      throw;
+    }
+
+    if (const std::uint64_t missing = required & ~given; missing != 0)
+      throw key_error(key_error::kind_type::missing,
+                      keys[icast<std::size_t>(std::countr_zero(missing))]);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (((given >> I & 1) == 0 ? assign_default(result, std::get<I>(Fields))
+                              : void()),
+       ...);
+    }(std::make_index_sequence<N>{});
+    return result;
+  }
+
+  /// `parse_fields` with the fields declared in `ArgParserTraits<T>::fields`
+  template <class T>
+  constexpr T parse_args_direct(std::string_view input,
+                                ArgParserOptions options = {}) {
+    return parse_fields<T, ArgParserTraits<T>::fields>(input, {}, options);
+  }
+} // namespace namedargs
@@ -6,6 +6,10 @@ namespace namedargs {
     return ('\t' <= c and c <= '\r') or c == ' ';
   }
 
+  constexpr bool isascii(char c) {
+    return static_cast<unsigned char>(c) < 0x80;
+  }
+
   constexpr bool isdigit(char c) { return '0' <= c and c <= '9'; }
 
   constexpr bool isupper(char c) { return 'A' <= c and c <= 'Z'; }
@@ -0,0 +1,97 @@
+/// @file datetime.hpp
+#pragma once
+#include <algorithm> // std::min
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <namedargs/ctype.hpp>
+#include <namedargs/parser.hpp>
+#include <namedargs/swar.hpp>
+
+namespace namedargs {
+  /// ISO-8601 date and time literals: `2026-10-16`, `2026-10-16T12:00:00Z`,
+  /// `2026-10-16T12:00:00.250+09:00`. A time without an offset is taken as
+  /// UTC; fractions finer than a microsecond are truncated. Detected by four
+  /// digits followed by '-', so it is to be tried before `int_kind`.
+  struct datetime_kind {
+    using value_type = std::chrono::sys_time<std::chrono::microseconds>;
+
+    static constexpr bool first(char c) { return namedargs::isdigit(c); }
+
+    static constexpr std::size_t
+    scan(std::string_view sv, value_type& out, const ArgParserOptions&) {
+      using namespace std::chrono;
+      constexpr swar_pattern date = make_swar_pattern("0000-00-");
+      constexpr swar_pattern day = make_swar_pattern("00");
+      constexpr swar_pattern time = make_swar_pattern("00T00:00");
+      constexpr swar_pattern secs = make_swar_pattern(":00");
+      constexpr std::uint64_t low4 = swar_ones * 0x0F; // '0'..'9' to 0..9
+
+      char buf[24]{};
+      for (std::size_t i = 0; i < std::min(sv.size(), sizeof(buf)); ++i)
+        buf[i] = sv[i];
+      const std::uint64_t w0 = load_u64(buf);
+      const std::uint64_t w1 = load_u64(buf + 8);
+      const std::uint64_t w2 = load_u64(buf + 16);
+      if (not swar_match(w0, make_swar_pattern("0000-")))
+        return 0;
+      if (not swar_match(w0, date) or not swar_match(w1, day))
+        throw parse_error("invalid datetime literal", sv.data());
+
+      // Digits as byte values; the separators become garbage bytes
+      const std::uint64_t d0 = w0 & low4, d1 = w1 & low4, d2 = w2 & low4;
+      auto two = [](std::uint64_t d, std::size_t i) {
+        return swar_byte(d, i) * 10 + swar_byte(d, i + 1);
+      };
+      const year_month_day ymd{year{static_cast<int>(two(d0, 0) * 100
+                                                     + two(d0, 2))},
+                               month{two(d0, 5)}, std::chrono::day{two(d1, 0)}};
+      if (not ymd.ok())
+        throw parse_error("invalid date", sv.data());
+      out = value_type{sys_days{ymd}};
+
+      std::size_t size = 10;
+      if (swar_match(w1, time) and swar_match(w2, secs)) {
+        const unsigned h = two(d1, 3), m = two(d1, 6), s = two(d2, 1);
+        if (23 < h or 59 < m or 59 < s)
+          throw parse_error("invalid time", sv.data() + 11);
+        out += hours{h} + minutes{m} + seconds{s};
+        size = 19;
+
+        // Fraction
+        if (sv.substr(size).starts_with('.')) {
+          std::int64_t us = 0, scale = 100000;
+          std::size_t i = size + 1;
+          for (; i < sv.size() and namedargs::isdigit(sv[i]); ++i, scale /= 10)
+            us += (sv[i] - '0') * scale;
+          if (i == size + 1)
+            throw parse_error("invalid time fraction", sv.data() + size);
+          out += microseconds{us};
+          size = i;
+        }
+
+        // Offset
+        const std::string_view rest = sv.substr(size);
+        if (rest.starts_with('Z') or rest.starts_with('z'))
+          size += 1;
+        else if (rest.starts_with('+') or rest.starts_with('-')) {
+          char off[8]{};
+          for (std::size_t i = 1; i < std::min<std::size_t>(rest.size(), 6); ++i)
+            off[i - 1] = rest[i];
+          const std::uint64_t w = load_u64(off);
+          const unsigned oh = two(w & low4, 0), om = two(w & low4, 3);
+          if (not swar_match(w, make_swar_pattern("00:00")) or 23 < oh
+              or 59 < om)
+            throw parse_error("invalid UTC offset", rest.data());
+          const minutes offset = hours{oh} + minutes{om};
+          out -= rest.front() == '+' ? offset : -offset;
+          size += 6;
+        }
+      }
+      if (size < sv.size() and isident2(sv[size]))
+        throw parse_error("invalid datetime literal", sv.data());
+      return size;
+    }
+  };
+} // namespace namedargs
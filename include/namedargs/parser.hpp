@@ -1,17 +1,32 @@
-/// @file fundamental.hpp
+/// @file parser.hpp
 #pragma once
-#include <algorithm> // std::min, std::find_if, std::sort, std::ranges::lower_bound
+#include <algorithm> // std::min, std::find_if, std::merge, std::ranges::lower_bound
+#include <array>
+#include <bit>     // std::countr_one
+#include <cstdint> // std::uint32_t
+#include <exception> // std::exception_ptr
 #include <functional> // std::invoke
+#include <iterator>   // std::back_inserter, std::make_move_iterator
+#include <memory>     // std::shared_ptr, std::unique_ptr
+#include <new>        // std::bad_alloc
 #include <optional>
 #include <span>
 #include <stdexcept> // std::runtime_error
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits> // std::is_constant_evaluated
+#include <unordered_set>
 #include <variant>
 #include <vector>
 #include <namedargs/ctype.hpp>
 #include <namedargs/from_chars.hpp>
 #include <namedargs/fundamental.hpp>
+#include <namedargs/simd.hpp>
+#include <namedargs/sort.hpp>
+#include <namedargs/structural.hpp>
+#include <namedargs/unicode.hpp>
+#include <namedargs/value.hpp>
 
 namespace namedargs {
   template <class T>
@@ -20,22 +35,163 @@ namespace namedargs {
   enum class TokenKind {
     num,   // Numeric literals
     str,   // String literals
+    value, // Literals of user-defined value kinds
     ident, // Identifiers
     punct, // Punctuators
     eof,   // End-of-file markers
   };
 
-  struct Token {
+  template <class Value>
+  struct BasicToken {
     TokenKind kind;
     std::string_view sv;
-    std::int64_t num; // Used if TokenKind::num
+    Value value{}; // Used if a literal
   };
 
+  using Token = BasicToken<tagged_value<std::int64_t, std::string_view>>;
+
+  constexpr std::string_view token_kind_name(TokenKind kind) {
+    switch (kind) {
+    case TokenKind::num:
+      return "number";
+    case TokenKind::str:
+      return "string";
+    case TokenKind::value:
+      return "value";
+    case TokenKind::ident:
+      return "identifier";
+    case TokenKind::punct:
+      return "punctuator";
+    default:
+      return "end of input";
+    }
+  }
+
+  /// Error raised while parsing. Records where in the input it occurred;
+  /// `set_input()` formats the line, column and caret snippet into a string
+  /// the error owns, so it stays valid after the input is gone.
   struct parse_error : std::runtime_error {
+  private:
+    const char* where_ = nullptr;
+    std::string_view expected_{};
+    std::size_t offset_ = std::string_view::npos;
+    // Immutable once set: copies of the error share it
+    std::shared_ptr<const std::string> formatted_{};
+
+  public:
     explicit parse_error(const std::string& msg) : std::runtime_error(msg) {}
     explicit parse_error(const char* msg) : std::runtime_error(msg) {}
+    /// `where` points into the input; `expected` describes what was expected
+    parse_error(const char* msg, const char* where,
+                std::string_view expected = {})
+      : std::runtime_error(msg), where_(where), expected_(expected) {}
     parse_error(const parse_error&) noexcept = default;
     ~parse_error() noexcept override = default;
+
+    /// Sets the input `where` points into and formats the error from it;
+    /// called by the parser. The error keeps no reference to `input`.
+    void set_input(std::string_view input) noexcept {
+      if (where_ == nullptr or input.data() == nullptr
+          or where_ < input.data() or input.data() + input.size() < where_)
+        return;
+      offset_ = static_cast<std::size_t>(where_ - input.data());
+      try {
+        formatted_ = std::make_shared<const std::string>(format(input));
+      } catch (...) {
+        formatted_.reset();
+      }
+    }
+
+    std::string_view expected() const noexcept { return expected_; }
+
+    /// Where in the input the error occurred, or nullptr if unknown. Only
+    /// meaningful while the input is alive.
+    const char* where() const noexcept { return where_; }
+
+    /// Offset of the failing token in the input, or npos if unknown
+    std::size_t offset() const noexcept { return offset_; }
+
+    /// "line:column: message", followed by the offending line with a caret
+    /// and the expected token if known
+    std::string format() const {
+      return formatted_ ? *formatted_ : std::runtime_error::what();
+    }
+
+    const char* what() const noexcept override {
+      return formatted_ ? formatted_->c_str() : std::runtime_error::what();
+    }
+
+  private:
+    std::string format(std::string_view input) const {
+      const std::size_t off = offset_;
+      const std::string_view head = input.substr(0, off);
+      // npos + 1 wraps to 0
+      const std::size_t line_begin = head.find_last_of('\n') + 1;
+      const std::size_t line_end =
+        std::min(input.find('\n', off), input.size());
+      const auto line = std::ranges::count(head, '\n');
+
+      std::string s = std::to_string(line + 1) + ':'
+                      + std::to_string(off - line_begin + 1) + ": "
+                      + std::runtime_error::what() + '\n';
+      s.append(input.substr(line_begin, line_end - line_begin));
+      s += '\n';
+      s.append(off - line_begin, ' ');
+      s += '^';
+      if (not expected_.empty()) {
+        s += "\nexpected: ";
+        s.append(expected_);
+      }
+      return s;
+    }
+  };
+
+  /// Reports an unknown or missing key without allocating; `key` refers to the
+  /// parsed input or to the field declaration
+  struct key_error : std::exception {
+    enum class kind_type { unknown, missing };
+    kind_type kind;
+    std::string_view key;
+
+    key_error(kind_type k, std::string_view sv) noexcept
+      : kind(k), key(sv) {}
+    const char* what() const noexcept override {
+      return kind == kind_type::unknown ? "unknown argument"
+                                        : "missing required argument";
+    }
+  };
+
+  /// Bounded buffer of errors collected by the recovery mode. Errors beyond
+  /// the capacity are only counted.
+  struct error_buffer {
+  private:
+    std::vector<parse_error> errors_{};
+    std::size_t capacity_;
+    std::size_t dropped_ = 0;
+
+  public:
+    explicit error_buffer(std::size_t capacity = 64) : capacity_(capacity) {
+      errors_.reserve(capacity);
+    }
+
+    void push(const parse_error& e) {
+      if (errors_.size() < capacity_)
+        errors_.push_back(e);
+      else
+        ++dropped_;
+    }
+
+    std::span<const parse_error> errors() const noexcept { return errors_; }
+    std::size_t dropped() const noexcept { return dropped_; }
+    std::size_t count() const noexcept { return errors_.size() + dropped_; }
+    bool empty() const noexcept { return count() == 0; }
+  };
+
+  struct ArgParserOptions {
+    /// Reject string literals which are not well-formed UTF-8
+    bool validate_utf8 = true;
+    /// Allow identifiers made of Unicode XID_Start/XID_Continue characters
+    bool unicode_identifiers = false;
   };
 
   template <class Pred>
@@ -47,38 +203,113 @@ namespace namedargs {
     return std::string_view::npos;
   }
 
-  constexpr std::optional<std::span<Token>> //
-  consume(TokenKind kind, std::span<Token> toks) {
+  template <class Tok>
+  constexpr std::optional<std::span<Tok>> //
+  consume(TokenKind kind, std::span<Tok> toks) {
     if (toks.front().kind == kind)
       return toks.subspan(1);
     else
       return std::nullopt;
   }
 
-  constexpr std::optional<std::span<Token>> //
-  consume_punct(std::string_view punct, std::span<Token> toks) {
+  template <class Tok>
+  constexpr std::optional<std::span<Tok>> //
+  consume_punct(std::string_view punct, std::span<Tok> toks) {
     if (toks.front().kind == TokenKind::punct and toks.front().sv == punct)
       return toks.subspan(1);
     else
       return std::nullopt;
   }
 
-  constexpr std::span<Token> //
-  expect(TokenKind kind, std::span<Token> toks) {
+  template <class Tok>
+  constexpr std::span<Tok> //
+  expect(TokenKind kind, std::span<Tok> toks) {
     if (toks.front().kind != kind)
-      throw parse_error("unexpected token");
+      throw parse_error("unexpected token", toks.front().sv.data(),
+                        token_kind_name(kind));
     return toks.subspan(1);
   }
 
-  constexpr std::span<Token> //
-  expect_punct(std::string_view punct, std::span<Token> toks) {
+  template <class Tok>
+  constexpr std::span<Tok> //
+  expect_punct(std::string_view punct, std::span<Tok> toks) {
     if (toks.front().kind != TokenKind::punct)
-      throw parse_error("unexpected token; expecting TokenKind::punct");
+      throw parse_error("unexpected token; expecting TokenKind::punct",
+                        toks.front().sv.data(), punct);
     if (toks.front().sv != punct)
-      throw parse_error("unexpected punctuator");
+      throw parse_error("unexpected punctuator", toks.front().sv.data(), punct);
     return toks.subspan(1);
   }
 
+  // Value kinds
+  //
+  // A value kind tells `BasicArgParser` how to tokenize one kind of literal:
+  //   using value_type = ...; // Trivially copyable, held in `tagged_value`
+  //   static constexpr bool first(char c);
+  //     True if a literal of the kind may start with `c`
+  //   static constexpr std::size_t
+  //   scan(std::string_view sv, value_type& out, const ArgParserOptions&);
+  //     Scans a literal at the head of `sv` and returns its length, or 0 if
+  //     `sv` does not start with one. Throws `parse_error` if malformed.
+  //   static constexpr TokenKind token_kind; // optional, TokenKind::value
+
+  /// Integer literals
+  struct int_kind {
+    using value_type = std::int64_t;
+    static constexpr TokenKind token_kind = TokenKind::num;
+
+    static constexpr bool first(char c) { return namedargs::isdigit(c); }
+
+    static constexpr std::size_t
+    scan(std::string_view sv, value_type& out, const ArgParserOptions&) {
+      const char* first = sv.data();
+      // Up to 18 digits cannot overflow
+      if (const std::size_t size = span_class(sv, char_class::digit);
+          size <= 18) {
+        out = 0;
+        for (std::size_t i = 0; i < size; ++i)
+          out = out * 10 + (first[i] - '0');
+        return size;
+      }
+      if (auto [ptr, ec] = from_chars(first, first + sv.size(), out);
+          ec == std::errc{})
+        return icast<std::size_t>(ptr - first);
+      else
+        throw parse_error("conversion from chars to integer failed", first);
+    }
+  };
+
+  /// String literals enclosed in single quotes
+  struct string_kind {
+    using value_type = std::string_view;
+    static constexpr TokenKind token_kind = TokenKind::str;
+
+    static constexpr bool first(char c) { return c == '\''; }
+
+    static constexpr std::size_t scan(std::string_view sv, value_type& out,
+                                      const ArgParserOptions& options) {
+      const char* quote = sv.data();
+      sv = sv.substr(1);
+      const std::size_t pos = span_class(sv, char_class::non_quote);
+      if (pos == sv.size())
+        throw parse_error("unclosed string literal", quote, "'");
+      if (options.validate_utf8)
+        if (const std::size_t bad = find_invalid_utf8(sv.substr(0, pos));
+            bad != std::string_view::npos)
+          throw parse_error("invalid UTF-8 in string literal", sv.data() + bad);
+      out = sv.substr(0, pos);
+      return pos + 2;
+    }
+  };
+
+  template <class Kind>
+  constexpr TokenKind kind_token_kind() {
+    if constexpr (requires { Kind::token_kind; })
+      return Kind::token_kind;
+    else
+      return TokenKind::value;
+  }
+
   template <class T, class U>
   constexpr auto find(const std::vector<std::pair<T, U>>& v, const T& key) {
     return std::find_if(v.begin(), v.end(),
@@ -94,93 +325,239 @@ namespace namedargs {
     variant_assignable_from_any_v<T, std::variant<Types...>> =
       (std::assignable_from<T, Types> or ...);
 
-  struct ArgParser {
+  template <class T, class... Types>
+  inline constexpr bool
+    variant_assignable_from_any_v<T, tagged_value<Types...>> =
+      (std::assignable_from<T, Types> or ...);
+
+  /// Assigns the alternative held by `arg` to `out`
+  template <class T, class Arg>
+  constexpr T& assign_arg(T& out, const Arg& arg) {
+    static_assert(variant_assignable_from_any_v<T&, Arg>);
+    using std::visit;
+    return visit(
+      [&out](const auto& x) -> T& {
+        if constexpr (std::assignable_from<T&, decltype(x)>)
+          return out = x;
+        else
+          throw parse_error("value is not assignable");
+      },
+      arg);
+  }
+
+  /// Parses named arguments whose values are literals of `Kinds`
+  template <class... Kinds>
+  struct BasicArgParser {
+    static_assert(sizeof...(Kinds) <= 32);
+    using ArgType = tagged_value<typename Kinds::value_type...>;
+    using Token = BasicToken<ArgType>;
+
   private:
-    using ArgType = std::variant<std::int64_t, std::string_view>;
     std::string_view input_{};
+    ArgParserOptions options_{};
     std::vector<Token> tokens_{};
-    std::vector<std::pair<std::string_view, ArgType>> args_{};
+    using ArgList = std::vector<std::pair<std::string_view, ArgType>>;
+    ArgList args_{};
+    // Columns of the sorted `args_` which searches touch: only key data
+    std::vector<std::uint64_t> prefixes_{}; // key_prefix of each key
+    std::vector<std::string_view> keys_{};
+    std::vector<std::uint8_t> kinds_{}; // Index of the value kind
+    // After `freeze()`: the prefixes in Eytzinger order (node k has the
+    // children 2k and 2k + 1, from 1) and the index in `args_` of each node
+    std::vector<std::uint64_t> tree_prefixes_{};
+    std::vector<std::uint32_t> tree_index_{};
 
   public:
-    constexpr explicit ArgParser(std::string_view input)
-      : input_(std::move(input)) {}
+    constexpr explicit BasicArgParser(std::string_view input,
+                                      ArgParserOptions options = {})
+      : input_(std::move(input)), options_(options) {}
 
-    // tokenize
+    /// Starts over on `input`, keeping the storage of the previous parse
+    constexpr void reset(std::string_view input,
+                         ArgParserOptions options = {}) {
+      input_ = input;
+      options_ = options;
+      tokens_.clear();
+      args_.clear();
+      prefixes_.clear();
+      keys_.clear();
+      kinds_.clear();
+      tree_prefixes_.clear();
+      tree_index_.clear();
+    }
 
-    constexpr std::string_view skip_whitespaces(std::string_view sv) {
-      const std::size_t pos =
-        std::min(find_if_not(sv, namedargs::isspace, 1), sv.size());
-      return sv.substr(pos);
+    /// Bytes of storage held, kept by `reset()`
+    constexpr std::size_t storage_bytes() const noexcept {
+      return tokens_.capacity() * sizeof(Token)
+             + args_.capacity() * sizeof(typename ArgList::value_type)
+             + (prefixes_.capacity() + tree_prefixes_.capacity())
+                 * sizeof(std::uint64_t)
+             + keys_.capacity() * sizeof(std::string_view) + kinds_.capacity()
+             + tree_index_.capacity() * sizeof(std::uint32_t);
     }
 
-    constexpr std::string_view tokenize_number(std::string_view sv) {
-      const char* first = sv.data();
-      std::int64_t num{};
-      if (auto [ptr, ec] = from_chars(first, first + sv.size(), num);
-          ec == std::errc{}) {
-        const std::size_t size = icast<std::size_t>(ptr - first);
-        tokens_.push_back({TokenKind::num, sv.substr(0, size), num});
-        return sv.substr(size);
-      } else
-        throw parse_error("conversion from chars to integer failed");
+    // tokenize
+
+    static constexpr std::string_view skip_whitespaces(std::string_view sv) {
+      return sv.substr(span_class(sv, char_class::space, 1));
     }
 
-    constexpr std::string_view tokenize_string_literal(std::string_view sv) {
-      sv = sv.substr(1);
-      const std::size_t pos = sv.find_first_of('\'');
-      if (pos == std::string_view::npos)
-        throw parse_error("unclosed string literal");
-      tokens_.push_back({TokenKind::str, sv.substr(0, pos), {}});
-      return sv.substr(pos + 1);
+    // Bit `i` of entry `c` is set if the `i`-th kind may start with `c`
+    static constexpr std::array<std::uint32_t, 256> kind_table = [] {
+      std::array<std::uint32_t, 256> table{};
+      for (std::size_t c = 0; c < table.size(); ++c) {
+        std::uint32_t bit = 1;
+        ((table[c] |= Kinds::first(static_cast<char>(c)) ? bit : 0, bit <<= 1),
+         ...);
+      }
+      return table;
+    }();
+
+    /// What a token starting with a character is
+    enum class token_start : std::uint8_t {
+      invalid,
+      space,
+      value, // Tried before the fallback in `fallback_table`
+      ident,
+      unicode, // Non-ASCII: an identifier if `unicode_identifiers`
+      punct,
+    };
+
+    static constexpr token_start fallback_start(char c) {
+      if (namedargs::isspace(c))
+        return token_start::space;
+      if (isident1(c))
+        return token_start::ident;
+      if (not isascii(c))
+        return token_start::unicode;
+      if (namedargs::ispunct(c))
+        return token_start::punct;
+      return token_start::invalid;
     }
 
-    constexpr std::string_view tokenize_identifier(std::string_view sv) {
-      const std::size_t pos = std::min(find_if_not(sv, isident2, 1), sv.size());
-      tokens_.push_back({TokenKind::ident, sv.substr(0, pos), {}});
-      return sv.substr(pos);
+    // Token start of each character, and the one tried if no value kind
+    // matches. Value kinds take precedence over the other token starts.
+    static constexpr std::array<token_start, 256> start_table = [] {
+      std::array<token_start, 256> table{};
+      for (std::size_t c = 0; c < table.size(); ++c)
+        table[c] = kind_table[c] != 0
+                     ? token_start::value
+                     : fallback_start(static_cast<char>(c));
+      return table;
+    }();
+
+    static constexpr std::array<token_start, 256> fallback_table = [] {
+      std::array<token_start, 256> table{};
+      for (std::size_t c = 0; c < table.size(); ++c)
+        table[c] = fallback_start(static_cast<char>(c));
+      return table;
+    }();
+
+    /// Tries the kinds in `mask` in order; returns the length of the literal,
+    /// or 0 if none of them matches
+    static constexpr std::size_t //
+    tokenize_value(std::string_view sv, Token& tok, std::uint32_t mask,
+                   const ArgParserOptions& options) {
+      std::size_t size = 0;
+      [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((size == 0 and (mask >> I & 1) != 0
+            ? void(size = tokenize_kind<I, Kinds>(sv, tok, options))
+            : void()),
+         ...);
+      }(std::index_sequence_for<Kinds...>{});
+      return size;
     }
 
-    constexpr std::string_view tokenize_punct(std::string_view sv) {
-      tokens_.push_back({TokenKind::punct, sv.substr(0, 1), {}});
-      return sv.substr(1);
+    template <std::size_t I, class Kind>
+    static constexpr std::size_t //
+    tokenize_kind(std::string_view sv, Token& tok,
+                  const ArgParserOptions& options) {
+      typename Kind::value_type value{};
+      const std::size_t size = Kind::scan(sv, value, options);
+      if (size != 0)
+        tok = {kind_token_kind<Kind>(), sv.substr(0, size),
+               ArgType(std::in_place_index<I>, std::move(value))};
+      return size;
     }
 
-    constexpr std::string_view tokenize() {
-      std::string_view sv = input_;
-      while (not sv.empty()) {
-        // Skip whitespace characters.
-        if (namedargs::isspace(sv.front())) {
-          sv = skip_whitespaces(sv);
-          continue;
+    static constexpr std::string_view //
+    tokenize_identifier(std::string_view sv, Token& tok,
+                        ArgParserOptions options = {}) {
+      const std::size_t first =
+        isascii(sv.front()) ? 1 : decode_utf8(sv).size;
+      std::size_t pos = span_class(sv, char_class::ident, first);
+      if (options.unicode_identifiers)
+        while (pos < sv.size() and not isascii(sv[pos])) {
+          const auto [cp, size] = decode_utf8(sv.substr(pos));
+          if (size == 0 or not is_xid_continue(cp))
+            break;
+          pos = span_class(sv, char_class::ident, pos + size);
         }
+      tok = {TokenKind::ident, sv.substr(0, pos), {}};
+      return sv.substr(pos);
+    }
 
-        // Numeric literal
-        if (namedargs::isdigit(sv.front())) {
-          sv = tokenize_number(sv);
-          continue;
-        }
+    static constexpr bool
+    starts_with_unicode_identifier(std::string_view sv) {
+      const auto [cp, size] = decode_utf8(sv);
+      return size != 0 and is_xid_start(cp);
+    }
 
-        // String literal
-        if (sv.starts_with('\'')) {
-          sv = tokenize_string_literal(sv);
-          continue;
-        }
+    static constexpr std::string_view //
+    tokenize_punct(std::string_view sv, Token& tok) {
+      tok = {TokenKind::punct, sv.substr(0, 1), {}};
+      return sv.substr(1);
+    }
 
-        // Identifier
-        if (isident1(sv.front())) {
-          sv = tokenize_identifier(sv);
-          continue;
-        }
+    /// Scans a token other than a value or whitespace
+    static constexpr std::string_view //
+    tokenize_start(token_start start, std::string_view sv, Token& tok,
+                   const ArgParserOptions& options) {
+      switch (start) {
+      case token_start::ident:
+        return tokenize_identifier(sv, tok, options);
+      case token_start::unicode:
+        if (options.unicode_identifiers and starts_with_unicode_identifier(sv))
+          return tokenize_identifier(sv, tok, options);
+        break;
+      case token_start::punct:
+        return tokenize_punct(sv, tok);
+      default:
+        break;
+      }
+      throw parse_error("unexpected character", sv.data());
+    }
 
-        // Punctuators
-        if (namedargs::ispunct(sv.front())) {
-          sv = tokenize_punct(sv);
+    /// Scans the token at the head of `sv` into `tok` and returns the rest.
+    /// Each token start is dispatched on `start_table` with one switch.
+    static constexpr std::string_view //
+    next_token(std::string_view sv, Token& tok, ArgParserOptions options = {}) {
+      while (not sv.empty()) {
+        const auto c = static_cast<unsigned char>(sv.front());
+        switch (start_table[c]) {
+        case token_start::space:
+          sv = skip_whitespaces(sv);
           continue;
+        case token_start::value:
+          if (const std::size_t size =
+                tokenize_value(sv, tok, kind_table[c], options))
+            return sv.substr(size);
+          return tokenize_start(fallback_table[c], sv, tok, options);
+        default:
+          return tokenize_start(start_table[c], sv, tok, options);
         }
-
-        throw parse_error("unexpected character");
       }
-      tokens_.push_back({TokenKind::eof, sv, {}});
+      tok = {TokenKind::eof, sv, {}};
+      return sv;
+    }
+
+    constexpr std::string_view tokenize() {
+      std::string_view sv = input_;
+      Token tok{};
+      do {
+        sv = next_token(sv, tok, options_);
+        tokens_.push_back(tok);
+      } while (tok.kind != TokenKind::eof);
       return sv;
     }
 
@@ -191,8 +568,10 @@ namespace namedargs {
       if (auto toks2 = consume(TokenKind::eof, toks))
         return *toks2;
       toks = parse_stmt(toks);
-      toks = expect(TokenKind::eof, toks);
-      return toks;
+      if (toks.front().kind != TokenKind::eof)
+        throw parse_error("unexpected token", toks.front().sv.data(),
+                          "',' or end of input");
+      return toks.subspan(1);
     }
 
     // stmt = assign ("," assign)*
@@ -209,32 +588,43 @@ namespace namedargs {
     // assign = ident "=" primary
     constexpr std::span<Token> parse_assign(std::span<Token> toks) {
       auto [ident, toks2] = parse_ident(toks);
-      toks2 = expect_punct("=", toks2);
-      auto [arg, toks3] = parse_primary(toks2);
-      args_.push_back({std::move(ident), std::move(arg)});
-      return toks3;
+      try {
+        toks2 = expect_punct("=", toks2);
+        auto [arg, toks3] = parse_primary(toks2);
+        args_.push_back({std::move(ident), std::move(arg)});
+        return toks3;
+      } catch (const parse_error&) {
+        // A repeated key is reported before the error after it
+        if (namedargs::find(args_, ident) != args_.end())
+          throw parse_error("argument already exists", ident.data());
+        throw;
+      }
     }
 
     constexpr std::pair<std::string_view, std::span<Token>>
     parse_ident(std::span<Token> toks) {
       if (toks.front().kind != TokenKind::ident)
-        throw parse_error("unexpected token; expecting TokenKind::ident");
-      if (auto it = namedargs::find(args_, toks.front().sv); it != args_.end())
-        throw parse_error("argument already exists");
+        throw parse_error("unexpected token; expecting TokenKind::ident",
+                          toks.front().sv.data(), "identifier");
       return {toks.front().sv, toks.subspan(1)};
     }
 
-    // primary = str | num
+    // primary = str | num | value
     constexpr std::pair<ArgType, std::span<Token>>
     parse_primary(std::span<Token> toks) {
-      switch (toks.front().kind) {
+      return {primary_value(toks.front()), toks.subspan(1)};
+    }
+
+    static constexpr ArgType primary_value(const Token& tok) {
+      switch (tok.kind) {
       case TokenKind::str:
-        return {toks.front().sv, toks.subspan(1)};
       case TokenKind::num:
-        return {toks.front().num, toks.subspan(1)};
+      case TokenKind::value:
+        return tok.value;
       default:
-        throw parse_error(
-          "unexpected token; expecting TokenKind::str or TokenKind::num");
+        // Any of the value kinds: the parser may have others than these two
+        throw parse_error("unexpected token; expecting a value",
+                          tok.sv.data(), token_kind_name(TokenKind::value));
       }
     }
 
@@ -244,45 +634,623 @@ namespace namedargs {
       return toks;
     }
 
+    /// Tokenizes and parses the input. At run time this calls the
+    /// out-of-line `execute_runtime()`, which the compiled library
+    /// `Iris::Compiled` instantiates once for `ArgParser`.
     constexpr void execute() {
-      tokenize();
-      parse();
-      std::sort(args_.begin(), args_.end(), [](const auto& x, const auto& y) {
-        return x.first.compare(y.first) < 0;
-      });
+      if (std::is_constant_evaluated())
+        execute_inline();
+      else
+        execute_runtime();
+    }
+
+    void execute_runtime();
+
+    /// Like `execute()`, but in two stages: `build_structural_index` finds
+    /// the `,` and `=` outside string literals, then each assignment between
+    /// two commas is tokenized on its own. Falls back to `execute()` on any
+    /// irregularity, so that errors are reported as usual. `execute()` uses
+    /// it from `structural_index_threshold` bytes.
+    void execute_indexed();
+
+    /// Like `execute_indexed()`, on `threads` threads (by default one per
+    /// core and MiB of input). The input is cut into equal chunks, each
+    /// indexed as if it started outside a string literal; the parity of the
+    /// quote counts then tells which chunks were mispredicted, and only
+    /// those are indexed again. Each thread parses and sorts the assignments
+    /// starting in its chunk, the sorted parts are merged pairwise in
+    /// parallel and duplicates are found in the merged list.
+    void execute_parallel(unsigned threads = 0);
+
+  private:
+    /// Parses the assignment `input_[begin, end)` whose first `=` is at
+    /// `eq` into `out`; false if it is not `ident = primary`
+    bool parse_segment(std::size_t begin, std::size_t eq, std::size_t end,
+                       ArgList& out) const;
+
+    /// Parses the assignments starting in `chunks[i]`, the structural
+    /// indexes of consecutive parts of the input, into `out`: those after
+    /// its first `,`, or all for `i == 0`. The last one may end in a later
+    /// chunk. Returns false if the input must be parsed by `execute()`.
+    bool parse_chunk(std::span<const structural_index> chunks, std::size_t i,
+                     ArgList& out) const;
+
+    /// Sorts `args` by key; false if a key is duplicated
+    static constexpr bool sort_unique(ArgList& args) {
+      return msd_sort(args.begin(), args.end(),
+                      [](const auto& x) { return x.first; });
+    }
+
+    /// Index of the first prefix not less than `prefix` in `prefixes_`: a
+    /// branch-free walk down the tree after `freeze()`
+    constexpr std::size_t lower_bound_frozen(std::uint64_t prefix) const {
+      const std::size_t n = tree_index_.size() - 1;
+      std::size_t k = 1;
+      while (k <= n) {
+        // 8 prefixes a cache line: the descendants 3 levels down
+        if (not std::is_constant_evaluated())
+          __builtin_prefetch(tree_prefixes_.data() + 8 * k);
+        k = 2 * k + (tree_prefixes_[k] < prefix);
+      }
+      // Undo the right turns after the last left one: that node holds the
+      // first prefix not less than `prefix`
+      k >>= std::countr_one(k) + 1;
+      return k == 0 ? n : tree_index_[k];
+    }
+
+    constexpr std::pair<typename ArgList::const_iterator, bool>
+    find_frozen(std::string_view key) const {
+      const std::uint64_t prefix = key_prefix(key);
+      const std::size_t n = prefixes_.size();
+      const std::size_t lo = lower_bound_frozen(prefix);
+      if (lo == n or prefixes_[lo] != prefix)
+        return {args_.end(), false};
+      // Keys sharing the prefix: usually only one
+      std::size_t hi = lo + 1;
+      if (hi < n and prefixes_[hi] == prefix)
+        hi = prefix == std::uint64_t(-1) ? n : lower_bound_frozen(prefix + 1);
+      return find_between(lo, hi, key);
+    }
+
+    /// `find()` among the keys [lo, hi)
+    constexpr std::pair<typename ArgList::const_iterator, bool>
+    find_between(std::size_t lo, std::size_t hi, std::string_view key) const {
+      const auto it =
+        std::lower_bound(keys_.begin() + icast<std::ptrdiff_t>(lo),
+                         keys_.begin() + icast<std::ptrdiff_t>(hi), key);
+      if (it == keys_.begin() + icast<std::ptrdiff_t>(hi) or *it != key)
+        return {args_.end(), false};
+      return {args_.begin() + (it - keys_.begin()), true};
+    }
+
+    /// Fills the key columns once `args_` is sorted
+    constexpr void index_keys() {
+      tree_prefixes_.clear();
+      tree_index_.clear();
+      const std::size_t n = args_.size();
+      prefixes_.resize(n);
+      keys_.resize(n);
+      kinds_.resize(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        keys_[i] = args_[i].first;
+        prefixes_[i] = key_prefix(keys_[i]);
+        kinds_[i] = static_cast<std::uint8_t>(args_[i].second.index());
+      }
+    }
+
+    /// Sorts `args_` by key. Throws at the repetition of a key which comes
+    /// first in the input, the error `parse()` used to report.
+    constexpr void sort_args() {
+      if (sort_unique(args_))
+        return index_keys();
+      // Equal keys are adjacent: take the least second occurrence
+      const char* where = nullptr;
+      for (auto it = args_.begin(), run = it; it != args_.end(); it = run) {
+        run = std::find_if(it, args_.end(), [&](const auto& x) {
+          return x.first != it->first;
+        });
+        if (run - it < 2)
+          continue;
+        const char* p1 = it->first.data();
+        const char* p2 = nullptr;
+        for (auto jt = it + 1; jt != run; ++jt) {
+          const char* p = jt->first.data();
+          if (p < p1) {
+            p2 = p1;
+            p1 = p;
+          } else if (p2 == nullptr or p < p2) {
+            p2 = p;
+          }
+        }
+        if (where == nullptr or p2 < where)
+          where = p2;
+      }
+      throw parse_error("argument already exists", where);
+    }
+
+    /// Runs `f(0)`, ..., `f(n - 1)` on `n` threads and waits for them
+    template <class F>
+    static void run_parallel(std::size_t n, F f);
+
+    constexpr void execute_inline() {
+      try {
+        tokenize();
+        try {
+          parse();
+        } catch (const parse_error&) {
+          // A key repeated before the error is reported instead
+          sort_args();
+          throw;
+        }
+        sort_args();
+      } catch (parse_error& e) {
+        e.set_input(input_);
+        throw;
+      }
+    }
+
+  public:
+    /// Like `execute()`, but records each error in `errors`, resynchronizes
+    /// at the next "," outside string literals and goes on. Arguments parsed
+    /// without error are kept. Returns true if no error occurred.
+    bool execute_recover(error_buffer& errors);
+
+    /// Skips past the next "," outside string literals
+    static constexpr std::string_view skip_to_separator(std::string_view sv) {
+      bool quoted = false;
+      for (std::size_t i = 0; i < sv.size(); ++i) {
+        if (sv[i] == '\'')
+          quoted = not quoted;
+        else if (sv[i] == ',' and not quoted)
+          return sv.substr(i + 1);
+      }
+      return sv.substr(sv.size());
+    }
+
+    /// The input being parsed
+    constexpr std::string_view input() const noexcept { return input_; }
+
+    /// Parsed arguments sorted by key (valid after `execute()`)
+    constexpr std::span<const std::pair<std::string_view, ArgType>>
+    args() const noexcept {
+      return args_;
+    }
+
+    /// The keys of `args()`, packed (valid after `execute()`)
+    constexpr std::span<const std::string_view> keys() const noexcept {
+      return keys_;
+    }
+
+    /// The value kind of each of `args()`: `args()[i].second.index()`, one
+    /// byte each for bulk scans (valid after `execute()`)
+    constexpr std::span<const std::uint8_t> kinds() const noexcept {
+      return kinds_;
     }
 
     constexpr std::pair<decltype(args_.cbegin()), bool> //
     find(std::string_view key) const {
-      auto it = std::ranges::lower_bound(args_.begin(), args_.end(), key, {},
-                                         [](const auto& x) { return x.first; });
-      if (it == args_.end() or key < it->first)
-        return {args_.end(), false};
-      else
-        return {it, true};
+      if (not tree_index_.empty())
+        return find_frozen(key);
+      // Binary search on the prefixes, then on the keys sharing the prefix
+      const auto [lo, hi] =
+        std::ranges::equal_range(prefixes_, key_prefix(key));
+      return find_between(icast<std::size_t>(lo - prefixes_.begin()),
+                          icast<std::size_t>(hi - prefixes_.begin()), key);
     }
 
+    /// Lays the keys out for faster `find()` on large argument sets queried
+    /// many times: in the order of a breadth-first walk of the binary search
+    /// tree, so that the first levels share cache lines and the next ones
+    /// can be prefetched. Undone by the next `execute()`.
+    constexpr void freeze() {
+      const std::size_t n = prefixes_.size();
+      tree_prefixes_.assign(n + 1, 0);
+      tree_index_.assign(n + 1, 0);
+      // The in-order walk of the tree visits the keys in sorted order
+      std::size_t i = 0;
+      auto fill = [&](auto& self, std::size_t k) -> void {
+        if (k > n)
+          return;
+        self(self, 2 * k);
+        tree_prefixes_[k] = prefixes_[i];
+        tree_index_[k] = static_cast<std::uint32_t>(i++);
+        self(self, 2 * k + 1);
+      };
+      fill(fill, 1);
+    }
+
+    /// True after `freeze()`
+    constexpr bool frozen() const noexcept { return not tree_index_.empty(); }
+
     template <class T, class U>
     constexpr T& assign_or(T& out, std::string_view key, U&& value) const {
       static_assert(variant_assignable_from_any_v<T&, ArgType>);
       if (auto [it, found] = find(key); found)
-        return std::visit(
-          [&out](const auto& x) -> T& {
-            if constexpr (std::assignable_from<T&, decltype(x)>)
-              return out = x;
-            else
-              throw parse_error("value is not assignable");
-          },
-          it->second);
+        return assign_arg(out, it->second);
       else
         return out = std::forward<U>(value);
     }
   };
 
-  template <class T>
+  // Defined out of class, so that `extern template` keeps them out of the
+  // translation units using the compiled library
+  template <class... Kinds>
+  void BasicArgParser<Kinds...>::execute_runtime() {
+    if (structural_index_threshold <= input_.size()
+        and input_.size() <= structural_index_max_size)
+      execute_indexed();
+    else
+      execute_inline();
+  }
+
+  template <class... Kinds>
+  bool BasicArgParser<Kinds...>::parse_segment(std::size_t begin,
+                                                std::size_t eq,
+                                                std::size_t end,
+                                                ArgList& out) const {
+    if (eq == std::string_view::npos)
+      return false;
+    const std::string_view sv = input_;
+    Token key{}, value{}, rest{};
+    next_token(next_token(sv.substr(begin, eq - begin), key, options_), rest,
+               options_);
+    if (key.kind != TokenKind::ident or rest.kind != TokenKind::eof)
+      return false;
+    next_token(next_token(sv.substr(eq + 1, end - eq - 1), value, options_),
+               rest, options_);
+    if (value.kind != TokenKind::str and value.kind != TokenKind::num
+        and value.kind != TokenKind::value)
+      return false;
+    if (rest.kind != TokenKind::eof)
+      return false;
+    out.push_back({key.sv, std::move(value.value)});
+    return true;
+  }
+
+  template <class... Kinds>
+  bool BasicArgParser<Kinds...>::parse_chunk(
+    std::span<const structural_index> chunks, std::size_t i,
+    ArgList& out) const {
+    if (chunks.back().unclosed_quote)
+      return false;
+    bool started = i == 0;
+    std::size_t begin = 0, eq = std::string_view::npos;
+    for (std::size_t j = i; j < chunks.size(); ++j) {
+      for (const std::uint32_t pos : chunks[j].positions) {
+        if (input_[pos] == ',') {
+          if (started) {
+            if (not parse_segment(begin, eq, pos, out))
+              return false;
+            if (j != i)
+              return true; // The rest belongs to chunk j
+          }
+          started = true;
+          begin = pos + std::size_t{1};
+          eq = std::string_view::npos;
+        } else if (input_[pos] == '=' and eq == std::string_view::npos)
+          eq = pos;
+      }
+      if (not started)
+        return true; // No assignment starts in chunk i
+    }
+    if (i == 0 and begin == 0 and eq == std::string_view::npos) {
+      // No assignment: valid only if blank
+      Token tok{};
+      next_token(input_, tok, options_);
+      return tok.kind == TokenKind::eof;
+    }
+    return parse_segment(begin, eq, input_.size(), out);
+  }
+
+  template <class... Kinds>
+  void BasicArgParser<Kinds...>::execute_indexed() {
+    bool ok = false;
+    try {
+      const structural_index index = build_structural_index(input_);
+      ok = parse_chunk(std::span(&index, 1), 0, args_) and sort_unique(args_);
+    } catch (const parse_error&) {
+      // Reported by `execute_inline()` below
+    }
+    if (ok)
+      return index_keys();
+    args_.clear();
+    execute_inline();
+  }
+
+  template <class... Kinds>
+  template <class F>
+  void BasicArgParser<Kinds...>::run_parallel(std::size_t n, F f) {
+    std::vector<std::exception_ptr> errors(n);
+    auto run = [&f, &errors](std::size_t t) {
+      try {
+        f(t);
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(n);
+    for (std::size_t t = 1; t < n; ++t)
+      pool.emplace_back(run, t);
+    if (n != 0)
+      run(0);
+    for (auto& thread : pool)
+      thread.join();
+    for (const auto& e : errors)
+      if (e)
+        std::rethrow_exception(e);
+  }
+
+  template <class... Kinds>
+  void BasicArgParser<Kinds...>::execute_parallel(unsigned threads) {
+    const std::size_t size = input_.size();
+    if (threads == 0)
+      threads = static_cast<unsigned>(
+        std::min<std::size_t>(std::thread::hardware_concurrency(),
+                              size >> 20));
+    if (threads <= 1 or size > structural_index_max_size)
+      return execute();
+
+    // Chunks of whole 64-byte blocks
+    const std::size_t chunk = (size / threads + 63) / 64 * 64;
+    auto first = [&](std::size_t t) { return std::min(t * chunk, size); };
+    std::vector<structural_index> chunks(threads);
+    run_parallel(threads, [&](std::size_t t) {
+      chunks[t] = build_structural_index(input_, first(t), first(t + 1));
+    });
+    // `unclosed_quote` of a chunk indexed from outside is the parity of its
+    // quotes. Index again the chunks which start inside a literal.
+    std::vector<std::size_t> redo;
+    bool quoted = false;
+    for (std::size_t t = 0; t < threads; ++t) {
+      if (quoted)
+        redo.push_back(t);
+      quoted = quoted != chunks[t].unclosed_quote;
+    }
+    run_parallel(redo.size(), [&](std::size_t k) {
+      const std::size_t t = redo[k];
+      chunks[t] = build_structural_index(input_, first(t), first(t + 1), true);
+    });
+
+    std::vector<ArgList> parts(threads);
+    std::vector<char> ok(threads, false); // Not vector<bool>: no data race
+    run_parallel(threads, [&](std::size_t t) {
+      try {
+        ok[t] = parse_chunk(chunks, t, parts[t]);
+      } catch (const parse_error&) {
+        // Reported by `execute_inline()` below
+      }
+      if (ok[t])
+        ok[t] = sort_unique(parts[t]);
+    });
+
+    if (std::find(ok.begin(), ok.end(), false) == ok.end()) {
+      // Merge pairwise: log2(threads) rounds
+      for (std::size_t step = 1; step < threads; step *= 2)
+        run_parallel((threads + 2 * step - 1) / (2 * step), [&](std::size_t k) {
+          const std::size_t t = 2 * k * step;
+          if (t + step >= threads)
+            return;
+          ArgList merged;
+          merged.reserve(parts[t].size() + parts[t + step].size());
+          std::merge(std::make_move_iterator(parts[t].begin()),
+                     std::make_move_iterator(parts[t].end()),
+                     std::make_move_iterator(parts[t + step].begin()),
+                     std::make_move_iterator(parts[t + step].end()),
+                     std::back_inserter(merged),
+                     [](const auto& x, const auto& y) {
+                       return x.first.compare(y.first) < 0;
+                     });
+          parts[t] = std::move(merged);
+          parts[t + step] = {};
+        });
+      args_ = std::move(parts[0]);
+      // Duplicates across chunks are adjacent after the merge
+      if (std::adjacent_find(args_.begin(), args_.end(),
+                             [](const auto& x, const auto& y) {
+                               return x.first == y.first;
+                             })
+          == args_.end())
+        return index_keys();
+    }
+    args_.clear();
+    execute_inline();
+  }
+
+  template <class... Kinds>
+  bool BasicArgParser<Kinds...>::execute_recover(error_buffer& errors) {
+    // Starts over like `execute()` after `reset()`
+    reset(input_, options_);
+    const std::size_t count = errors.count();
+    std::string_view sv = input_;
+    Token tok{};
+    bool lexed = false;
+    auto next = [&] {
+      lexed = false;
+      sv = next_token(sv, tok, options_);
+      lexed = true;
+      return std::span<Token>(&tok, 1);
+    };
+
+    std::unordered_set<std::string_view> keys;
+    bool first = true;
+    for (bool done = false; not done;) {
+      try {
+        if (next().front().kind == TokenKind::eof and first)
+          break;
+        first = false;
+        // assign = ident "=" primary
+        const auto ident = parse_ident(std::span<Token>(&tok, 1)).first;
+        if (keys.contains(ident))
+          throw parse_error("argument already exists", ident.data());
+        expect_punct("=", next());
+        next();
+        args_.push_back({ident, primary_value(tok)});
+        keys.insert(ident);
+        // ("," assign)*
+        if (not consume_punct(",", next())) {
+          if (tok.kind != TokenKind::eof)
+            throw parse_error("unexpected token", tok.sv.data(),
+                              "',' or end of input");
+          done = true;
+        }
+      } catch (parse_error& e) {
+        e.set_input(input_);
+        errors.push(e);
+        if (lexed and tok.kind == TokenKind::eof)
+          break;
+        if (lexed and tok.kind == TokenKind::punct and tok.sv == ",")
+          continue;
+        // A token which failed to scan is skipped from its start, where
+        // `sv` still is: the error may point inside a string literal
+        sv = skip_to_separator(sv);
+        done = sv.empty();
+      }
+    }
+    sort_unique(args_);
+    index_keys();
+    return errors.count() == count;
+  }
+
+  using ArgParser = BasicArgParser<int_kind, string_kind>;
+
+#ifdef NAMEDARGS_SEPARATE_COMPILATION
+  // Instantiated in src/parser.cpp (target Iris::Compiled)
+  extern template struct BasicArgParser<int_kind, string_kind>;
+#endif
+
+  /// Wraps `ArgParser` for strict hand-written conversions: records which
+  /// arguments have been consumed in a bitset indexed like `args()`, so that
+  /// unknown keys are found without comparing any strings.
+  template <class Parser = ArgParser>
+  struct ArgChecker {
+  private:
+    using ArgType = typename Parser::ArgType;
+    const Parser& parser_;
+    std::vector<bool> consumed_;
+
+    constexpr const ArgType* consume(std::string_view key) {
+      auto [it, found] = parser_.find(key);
+      if (not found)
+        return nullptr;
+      const auto i = icast<std::size_t>(&*it - parser_.args().data());
+      consumed_[i] = true;
+      return &it->second;
+    }
+
+  public:
+    constexpr explicit ArgChecker(const Parser& parser)
+      : parser_(parser), consumed_(parser.args().size(), false) {}
+
+    template <class T, class U>
+    constexpr T& assign_or(T& out, std::string_view key, U&& value) {
+      static_assert(variant_assignable_from_any_v<T&, ArgType>);
+      if (const auto* arg = consume(key))
+        return assign_arg(out, *arg);
+      else
+        return out = std::forward<U>(value);
+    }
+
+    template <class T>
+    constexpr T& assign_required(T& out, std::string_view key) {
+      static_assert(variant_assignable_from_any_v<T&, ArgType>);
+      if (const auto* arg = consume(key))
+        return assign_arg(out, *arg);
+      else
+        throw key_error(key_error::kind_type::missing, key);
+    }
+
+    /// Throws `key_error` for the first argument not consumed so far
+    constexpr void check_unknown() const {
+      if (auto it = std::ranges::find(consumed_, false); it != consumed_.end())
+        throw key_error(
+          key_error::kind_type::unknown,
+          parser_.args()[icast<std::size_t>(it - consumed_.begin())].first);
+    }
+  };
+
+  /// Parsers retaining more storage than this are freed when given back
+  inline constexpr std::size_t parser_pool_max_bytes = std::size_t{1} << 20;
+
+  /// Parsers kept per thread and parser type
+  inline constexpr std::size_t parser_pool_max_size = 4;
+
+  /// Parsers kept by each thread for reuse. A parse borrows one, reset on
+  /// its input, and gives it back with its storage, so that the parses of a
+  /// thread stop allocating once the storage has grown to their size.
+  template <class Parser>
+  class parser_pool {
+  public:
+    /// A borrowed parser, given back on destruction
+    class lease {
+    public:
+      explicit lease(std::unique_ptr<Parser> parser) noexcept
+        : parser_(std::move(parser)) {}
+      lease(lease&&) noexcept = default;
+      lease& operator=(lease&&) = delete;
+      ~lease() {
+        if (parser_)
+          give_back(std::move(parser_));
+      }
+
+      Parser& operator*() const noexcept { return *parser_; }
+      Parser* operator->() const noexcept { return parser_.get(); }
+
+    private:
+      std::unique_ptr<Parser> parser_;
+    };
+
+    /// A parser of this thread, reset on `input`
+    static lease borrow(std::string_view input,
+                        ArgParserOptions options = {}) {
+      auto& parsers = free_list();
+      if (parsers.empty())
+        return lease(std::make_unique<Parser>(input, options));
+      lease l(std::move(parsers.back()));
+      parsers.pop_back();
+      l->reset(input, options);
+      return l;
+    }
+
+    /// Parsers given back and kept by this thread
+    static std::size_t size() noexcept { return free_list().size(); }
+
+  private:
+    static std::vector<std::unique_ptr<Parser>>& free_list() noexcept {
+      thread_local std::vector<std::unique_ptr<Parser>> parsers;
+      return parsers;
+    }
+
+    static void give_back(std::unique_ptr<Parser> parser) noexcept {
+      auto& parsers = free_list();
+      // After a huge input, or beyond the parsers nested parses needed
+      if (parser->storage_bytes() > parser_pool_max_bytes
+          or parsers.size() >= parser_pool_max_size)
+        return;
+      try {
+        parsers.push_back(std::move(parser));
+      } catch (const std::bad_alloc&) {
+        // Not kept
+      }
+    }
+  };
+
+  template <class T, class Parser>
+  auto parse_args_pooled(std::string_view sv)
+    -> decltype(ArgParserTraits<T>::convert(std::declval<Parser>())) {
+    auto parser = parser_pool<Parser>::borrow(sv);
+    parser->execute();
+    return ArgParserTraits<T>::convert(*parser);
+  }
+
+  /// Parses `sv` and converts it with `ArgParserTraits<T>::convert`. At run
+  /// time the parser is borrowed from `parser_pool<Parser>`.
+  template <class T, class Parser = ArgParser>
   constexpr auto parse_args(std::string_view sv)
-    -> decltype(ArgParserTraits<T>::convert(std::declval<ArgParser>())) {
-    ArgParser parser(sv);
+    -> decltype(ArgParserTraits<T>::convert(std::declval<Parser>())) {
+    if (not std::is_constant_evaluated())
+      return parse_args_pooled<T, Parser>(sv);
+    Parser parser(sv);
     parser.execute();
     return ArgParserTraits<T>::convert(parser);
   }
@@ -0,0 +1,274 @@
+/// @file simd.hpp
+#pragma once
+#include <algorithm> // std::min
+#include <array>
+#include <bit>     // std::countr_zero
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstdlib> // std::getenv
+#include <string_view>
+#include <type_traits> // std::is_constant_evaluated
+#include <namedargs/ctype.hpp>
+#include <namedargs/swar.hpp>
+#if (defined(__x86_64__) or defined(__i386__)) and defined(__GNUC__)
+#include <immintrin.h>
+#define NAMEDARGS_HAS_X86_DISPATCH 1
+#endif
+
+namespace namedargs {
+  /// Byte classes scanned by the tokenizer kernels
+  enum class char_class : unsigned char { space, ident, digit, non_quote };
+
+  inline constexpr std::size_t char_class_count = 4;
+
+  constexpr bool in_class(char c, char_class cls) noexcept {
+    switch (cls) {
+    case char_class::space:
+      return namedargs::isspace(c);
+    case char_class::ident:
+      return isident2(c);
+    case char_class::digit:
+      return namedargs::isdigit(c);
+    default:
+      return c != '\'';
+    }
+  }
+
+  /// High bits of the bytes of `x` in `cls`
+  constexpr std::uint64_t swar_class(std::uint64_t x, char_class cls) noexcept {
+    switch (cls) {
+    case char_class::space:
+      return swar_between(x, '\t', '\r') | swar_eq(x, ' ');
+    case char_class::ident:
+      return swar_digit(x) | swar_eq(x, '_')
+             | (swar_between(x | swar_ones * 0x20, 'a', 'z') & ~x);
+    case char_class::digit:
+      return swar_digit(x);
+    default:
+      return ~swar_eq(x, '\'') & swar_high;
+    }
+  }
+
+  /// Length of the prefix of [p, p + n) whose bytes are in `cls`, 8 bytes
+  /// at a time. Also used in constant evaluation.
+  constexpr std::size_t
+  span_scalar(const char* p, std::size_t n, char_class cls) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+      if (const std::uint64_t out = ~swar_class(load_u64(p + i), cls)
+                                    & swar_high;
+          out != 0)
+        return i + static_cast<std::size_t>(std::countr_zero(out)) / 8;
+    while (i < n and in_class(p[i], cls))
+      ++i;
+    return i;
+  }
+
+  /// Instruction set levels of the scanning kernels, in increasing order
+  enum class simd_level : unsigned char { scalar, sse2, avx2, avx512 };
+
+  constexpr std::string_view simd_level_name(simd_level level) noexcept {
+    constexpr std::string_view names[] = {"scalar", "sse2", "avx2", "avx512"};
+    return names[static_cast<std::size_t>(level)];
+  }
+
+  using span_kernel = std::size_t (*)(const char*, std::size_t);
+
+  /// Kernels of one level, indexed by `char_class`
+  struct scan_kernels {
+    simd_level level;
+    std::array<span_kernel, char_class_count> span;
+  };
+
+  template <char_class C>
+  std::size_t span_scalar_kernel(const char* p, std::size_t n) noexcept {
+    return span_scalar(p, n, C);
+  }
+
+#ifdef NAMEDARGS_HAS_X86_DISPATCH
+  // Each kernel compares a block of bytes at once and finishes the tail with
+  // `span_scalar`. Bytes >= 0x80 compare negative as signed chars, so they
+  // never fall in an ASCII range.
+
+  [[gnu::target("sse2")]] inline __m128i
+  sse2_between(__m128i v, char lo, char hi) noexcept {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(char(lo - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8(char(hi + 1))));
+  }
+
+  template <char_class C>
+  [[gnu::target("sse2")]] std::size_t
+  span_sse2_kernel(const char* p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+      const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+      __m128i m;
+      if constexpr (C == char_class::space)
+        m = _mm_or_si128(sse2_between(v, '\t', '\r'),
+                         _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+      else if constexpr (C == char_class::ident)
+        m = _mm_or_si128(
+          _mm_or_si128(sse2_between(v, '0', '9'),
+                       _mm_cmpeq_epi8(v, _mm_set1_epi8('_'))),
+          sse2_between(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z'));
+      else if constexpr (C == char_class::digit)
+        m = sse2_between(v, '0', '9');
+      else
+        m = _mm_cmpeq_epi8(v, _mm_set1_epi8('\''));
+      unsigned out = static_cast<unsigned>(_mm_movemask_epi8(m));
+      if constexpr (C != char_class::non_quote)
+        out = ~out & 0xFFFF;
+      if (out != 0)
+        return i + static_cast<std::size_t>(std::countr_zero(out));
+    }
+    return i + span_scalar(p + i, n - i, C);
+  }
+
+  [[gnu::target("avx2")]] inline __m256i
+  avx2_between(__m256i v, char lo, char hi) noexcept {
+    return _mm256_and_si256(
+      _mm256_cmpgt_epi8(v, _mm256_set1_epi8(char(lo - 1))),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(char(hi + 1)), v));
+  }
+
+  template <char_class C>
+  [[gnu::target("avx2")]] std::size_t
+  span_avx2_kernel(const char* p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+      const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+      __m256i m;
+      if constexpr (C == char_class::space)
+        m = _mm256_or_si256(avx2_between(v, '\t', '\r'),
+                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+      else if constexpr (C == char_class::ident)
+        m = _mm256_or_si256(
+          _mm256_or_si256(avx2_between(v, '0', '9'),
+                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'))),
+          avx2_between(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z'));
+      else if constexpr (C == char_class::digit)
+        m = avx2_between(v, '0', '9');
+      else
+        m = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\''));
+      auto out = static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+      if constexpr (C != char_class::non_quote)
+        out = ~out;
+      if (out != 0)
+        return i + static_cast<std::size_t>(std::countr_zero(out));
+    }
+    return i + span_sse2_kernel<C>(p + i, n - i);
+  }
+
+  [[gnu::target("avx512f,avx512bw")]] inline __mmask64
+  avx512_between(__m512i v, char lo, char hi) noexcept {
+    return _mm512_cmpge_epu8_mask(v, _mm512_set1_epi8(lo))
+           & _mm512_cmple_epu8_mask(v, _mm512_set1_epi8(hi));
+  }
+
+  template <char_class C>
+  [[gnu::target("avx512f,avx512bw")]] std::size_t
+  span_avx512_kernel(const char* p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+      const __m512i v = _mm512_loadu_si512(p + i);
+      __mmask64 m;
+      if constexpr (C == char_class::space)
+        m = avx512_between(v, '\t', '\r')
+            | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(' '));
+      else if constexpr (C == char_class::ident)
+        m = avx512_between(v, '0', '9')
+            | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('_'))
+            | avx512_between(_mm512_or_si512(v, _mm512_set1_epi8(0x20)),
+                             'a', 'z');
+      else if constexpr (C == char_class::digit)
+        m = avx512_between(v, '0', '9');
+      else
+        m = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\''));
+      std::uint64_t out = m;
+      if constexpr (C != char_class::non_quote)
+        out = ~out;
+      if (out != 0)
+        return i + static_cast<std::size_t>(std::countr_zero(out));
+    }
+    return i + span_avx2_kernel<C>(p + i, n - i);
+  }
+#endif
+
+  /// Kernels of `level`
+  constexpr scan_kernels scan_kernels_for(simd_level level) noexcept {
+    using enum char_class;
+    switch (level) {
+#ifdef NAMEDARGS_HAS_X86_DISPATCH
+    case simd_level::avx512:
+      return {level,
+              {span_avx512_kernel<space>, span_avx512_kernel<ident>,
+               span_avx512_kernel<digit>, span_avx512_kernel<non_quote>}};
+    case simd_level::avx2:
+      return {level,
+              {span_avx2_kernel<space>, span_avx2_kernel<ident>,
+               span_avx2_kernel<digit>, span_avx2_kernel<non_quote>}};
+    case simd_level::sse2:
+      return {level,
+              {span_sse2_kernel<space>, span_sse2_kernel<ident>,
+               span_sse2_kernel<digit>, span_sse2_kernel<non_quote>}};
+#endif
+    default:
+      return {simd_level::scalar,
+              {span_scalar_kernel<space>, span_scalar_kernel<ident>,
+               span_scalar_kernel<digit>, span_scalar_kernel<non_quote>}};
+    }
+  }
+
+  /// The best level the CPU (and the OS) supports, detected with cpuid
+  inline simd_level supported_simd_level() noexcept {
+#ifdef NAMEDARGS_HAS_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw"))
+      return simd_level::avx512;
+    if (__builtin_cpu_supports("avx2"))
+      return simd_level::avx2;
+    if (__builtin_cpu_supports("sse2"))
+      return simd_level::sse2;
+#endif
+    return simd_level::scalar;
+  }
+
+  /// `supported_simd_level()`, lowered to the level named by the environment
+  /// variable NAMEDARGS_SIMD (scalar, sse2, avx2 or avx512) if it is set
+  inline simd_level selected_simd_level() noexcept {
+    simd_level level = supported_simd_level();
+    if (const char* env = std::getenv("NAMEDARGS_SIMD"))
+      for (unsigned i = 0; i <= static_cast<unsigned>(level); ++i)
+        if (simd_level_name(static_cast<simd_level>(i)) == env)
+          return static_cast<simd_level>(i);
+    return level;
+  }
+
+  /// Kernels of `selected_simd_level()`, resolved at first use
+  inline scan_kernels& active_scan_kernels() noexcept {
+    static scan_kernels kernels = scan_kernels_for(selected_simd_level());
+    return kernels;
+  }
+
+  /// Switches the active kernels to `level`, or the best supported level
+  /// below it. Not thread-safe; meant for tests and differential fuzzing.
+  inline simd_level use_simd_level(simd_level level) noexcept {
+    level = std::min(level, supported_simd_level());
+    active_scan_kernels() = scan_kernels_for(level);
+    return level;
+  }
+
+  /// Length of the prefix of `sv` from `pos` whose bytes are in `cls`, plus
+  /// `pos`. Dispatches to the active kernel at run time.
+  constexpr std::size_t span_class(std::string_view sv, char_class cls,
+                                   std::size_t pos = 0) noexcept {
+    const char* p = sv.data() + pos;
+    const std::size_t n = sv.size() - pos;
+    if (std::is_constant_evaluated())
+      return pos + span_scalar(p, n, cls);
+    const auto& kernels = active_scan_kernels();
+    return pos + kernels.span[static_cast<std::size_t>(cls)](p, n);
+  }
+} // namespace namedargs
@@ -0,0 +1,163 @@
+/// @file sort.hpp
+#pragma once
+#include <algorithm> // std::adjacent_find, std::iter_swap, std::sort
+#include <array>
+#include <compare> // std::strong_ordering
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint16_t, std::uint64_t
+#include <iterator> // std::iterator_traits
+#include <string_view>
+#include <utility> // std::swap
+#include <vector>
+#include <namedargs/fundamental.hpp>
+#include <namedargs/swar.hpp>
+
+namespace namedargs {
+  // Most significant digit radix sort of string keys, one byte per pass.
+  // The elements are permuted into their buckets in place (American flag
+  // sort). Keys which end at the current byte make up bucket 0 and are all
+  // equal, so duplicates are found by the sort itself.
+
+  /// Ranges shorter than this are sorted by comparison
+  inline constexpr std::size_t msd_sort_cutoff = 32;
+
+  /// Radix passes stop at this depth: ranges whose keys share a longer
+  /// prefix are sorted by comparison
+  inline constexpr std::size_t msd_sort_max_depth = 64;
+
+  /// Sorts [first, last), whose keys share their first `depth` bytes, by
+  /// comparison. Returns false if two keys are equal.
+  template <class It, class Key>
+  constexpr bool compare_sort_from(It first, It last, Key key,
+                                   std::size_t depth) {
+    std::sort(first, last, [&](const auto& x, const auto& y) {
+      return key(x).substr(depth) < key(y).substr(depth);
+    });
+    return std::adjacent_find(first, last,
+                              [&](const auto& x, const auto& y) {
+                                return key(x).substr(depth)
+                                       == key(y).substr(depth);
+                              })
+           == last;
+  }
+
+  /// `msd_sort` of [first, last), whose keys share their first `depth`
+  /// bytes, with `buckets[i]`, scratch space for the bucket of `first[i]`
+  template <class It, class Key>
+  constexpr bool msd_sort_with(It first, It last, Key key, std::size_t depth,
+                               std::uint16_t* buckets) {
+    using diff = typename std::iterator_traits<It>::difference_type;
+    struct range {
+      std::size_t begin, end, depth;
+    };
+    // Buckets left to sort, as offsets from `first`. A stack rather than
+    // recursion: the nesting follows the shared prefixes of the keys.
+    std::vector<range> pending{
+      {0, static_cast<std::size_t>(last - first), depth}};
+    bool distinct = true;
+    while (not pending.empty()) {
+      auto [lo, hi, d] = pending.back();
+      pending.pop_back();
+      const It f = first + icast<diff>(lo);
+      const std::size_t n = hi - lo;
+      std::uint16_t* const b = buckets + lo;
+      if (n < msd_sort_cutoff) {
+        distinct = compare_sort_from(f, f + icast<diff>(n), key, d)
+                   and distinct;
+        continue;
+      }
+      // Counts, then the end of each bucket. Bucket 0: keys ending here.
+      // While the keys all fall in one bucket, goes on with the next byte.
+      std::array<std::size_t, 257> end{};
+      for (; d < msd_sort_max_depth; ++d) {
+        end.fill(0);
+        It it = f;
+        for (std::size_t i = 0; i < n; ++i, ++it) {
+          const std::string_view k = key(*it);
+          b[i] = k.size() > d ? static_cast<std::uint16_t>(
+                                  static_cast<unsigned char>(k[d]) + 1)
+                              : std::uint16_t{0};
+          ++end[b[i]];
+        }
+        if (end[b[0]] != n or b[0] == 0)
+          break;
+      }
+      if (d >= msd_sort_max_depth) {
+        distinct = compare_sort_from(f, f + icast<diff>(n), key, d)
+                   and distinct;
+        continue;
+      }
+      if (end[b[0]] == n) {
+        // All the keys end here
+        distinct = false;
+        continue;
+      }
+      std::array<std::size_t, 257> next{};
+      for (std::size_t k = 0, sum = 0; k < 257; ++k) {
+        next[k] = sum;
+        end[k] = sum += end[k];
+      }
+      for (std::size_t k = 0; k < 257; ++k)
+        while (next[k] < end[k]) {
+          const std::size_t i = next[k];
+          const std::size_t to = b[i];
+          if (to == k) {
+            ++next[k];
+          } else {
+            const std::size_t j = next[to]++;
+            std::iter_swap(f + icast<diff>(i), f + icast<diff>(j));
+            std::swap(b[i], b[j]);
+          }
+        }
+      distinct = distinct and end[0] <= 1;
+      for (std::size_t k = 1; k < 257; ++k)
+        if (end[k] - end[k - 1] > 1)
+          pending.push_back({lo + end[k - 1], lo + end[k], d + 1});
+    }
+    return distinct;
+  }
+
+  /// Sorts [first, last) by the string view `key(x)` in byte order, as
+  /// `std::string_view::compare` does. Returns false if two keys are equal.
+  template <class It, class Key>
+  constexpr bool msd_sort(It first, It last, Key key) {
+    std::vector<std::uint16_t> buckets(
+      static_cast<std::size_t>(last - first));
+    return msd_sort_with(first, last, key, 0, buckets.data());
+  }
+
+  /// The first 8 bytes of `key` as a big-endian word, zero-padded: keys
+  /// with different prefixes compare like the prefixes
+  constexpr std::uint64_t key_prefix(std::string_view key) noexcept {
+    if (key.size() >= 8)
+      return __builtin_bswap64(load_u64(key.data()));
+    std::uint64_t x = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+      x = x << 8
+          | (i < key.size() ? static_cast<unsigned char>(key[i]) : 0u);
+    return x;
+  }
+
+  /// A key with its prefix inline: most comparisons are one integer
+  /// comparison, the bytes are compared only on equal prefixes
+  struct prefixed_key {
+    std::uint64_t prefix = 0;
+    std::string_view sv;
+
+    constexpr prefixed_key() noexcept = default;
+    constexpr prefixed_key(std::string_view key) noexcept
+      : prefix(key_prefix(key)), sv(key) {}
+
+    friend constexpr bool operator==(const prefixed_key& x,
+                                     const prefixed_key& y) noexcept {
+      return x.prefix == y.prefix and x.sv == y.sv;
+    }
+
+    friend constexpr std::strong_ordering
+    operator<=>(const prefixed_key& x, const prefixed_key& y) noexcept {
+      if (x.prefix != y.prefix)
+        return x.prefix <=> y.prefix;
+      return x.sv.compare(y.sv) <=> 0;
+    }
+  };
+} // namespace namedargs
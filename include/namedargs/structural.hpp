@@ -0,0 +1,128 @@
+/// @file structural.hpp
+#pragma once
+#include <algorithm> // std::min
+#include <bit>       // std::countr_zero
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <cstring>   // std::memcpy
+#include <limits>
+#include <string_view>
+#include <vector>
+#include <namedargs/simd.hpp>
+#include <namedargs/swar.hpp>
+
+namespace namedargs {
+  // Stage one of the indexed parse: the offsets of the structural
+  // characters `=`, `,` and `'`, with `=` and `,` inside string literals
+  // masked out. Literals have no escapes, so a byte is inside one iff an
+  // odd number of quotes precede it: the prefix XOR of the quote bits.
+  // Value kinds other than string literals are assumed to contain none of
+  // the structural characters.
+
+  struct structural_index {
+    std::vector<std::uint32_t> positions; // Offsets in the whole input
+    bool unclosed_quote = false;          // Ends inside a string literal
+  };
+
+  /// Bits of the bytes of a 64-byte block equal to each structural character
+  struct structural_masks {
+    std::uint64_t quote = 0, eq = 0, comma = 0;
+  };
+
+  /// Moves the high bit of each byte of `x` to bit `i` of the result
+  constexpr std::uint64_t swar_movemask(std::uint64_t x) noexcept {
+    return ((x >> 7) & swar_ones) * 0x0102040810204080 >> 56;
+  }
+
+  constexpr structural_masks
+  structural_block_scalar(const char* p) noexcept {
+    structural_masks m;
+    for (std::size_t i = 0; i < 8; ++i) {
+      const std::uint64_t x = load_u64(p + 8 * i);
+      m.quote |= swar_movemask(swar_eq(x, '\'')) << (8 * i);
+      m.eq |= swar_movemask(swar_eq(x, '=')) << (8 * i);
+      m.comma |= swar_movemask(swar_eq(x, ',')) << (8 * i);
+    }
+    return m;
+  }
+
+#ifdef NAMEDARGS_HAS_X86_DISPATCH
+  [[gnu::target("avx2")]] inline std::uint64_t
+  avx2_eq_mask(__m256i lo, __m256i hi, char c) noexcept {
+    const __m256i cc = _mm256_set1_epi8(c);
+    const auto l = static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, cc)));
+    const auto h = static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, cc)));
+    return std::uint64_t{h} << 32 | l;
+  }
+
+  [[gnu::target("avx2")]] inline structural_masks
+  structural_block_avx2(const char* p) noexcept {
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i hi =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    return {avx2_eq_mask(lo, hi, '\''), avx2_eq_mask(lo, hi, '='),
+            avx2_eq_mask(lo, hi, ',')};
+  }
+#endif
+
+  /// Bit `i` is the XOR of bits [0, i] of `x`
+  constexpr std::uint64_t prefix_xor(std::uint64_t x) noexcept {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+  }
+
+  /// Builds the structural index of `input[first, last)`, which starts
+  /// inside a string literal if `quoted`, 64 bytes at a time. The blocks are
+  /// classified with AVX2 if the active scanning level allows it.
+  inline structural_index
+  build_structural_index(std::string_view input, std::size_t first = 0,
+                         std::size_t last = std::string_view::npos,
+                         bool quoted = false) {
+    last = std::min(last, input.size());
+    structural_index index;
+    index.positions.reserve((last - first) / 8);
+#ifdef NAMEDARGS_HAS_X86_DISPATCH
+    const bool avx2 = active_scan_kernels().level >= simd_level::avx2;
+#endif
+    // All ones if the previous block ended quoted
+    std::uint64_t inside = quoted ? ~std::uint64_t{0} : 0;
+    for (std::size_t base = first; base < last; base += 64) {
+      const char* p = input.data() + base;
+      char tail[64]{};
+      if (last - base < 64) {
+        std::memcpy(tail, p, last - base);
+        p = tail;
+      }
+      structural_masks m;
+#ifdef NAMEDARGS_HAS_X86_DISPATCH
+      if (avx2)
+        m = structural_block_avx2(p);
+      else
+#endif
+        m = structural_block_scalar(p);
+      // Opening quotes and the bytes they cover are set
+      const std::uint64_t in_literal = prefix_xor(m.quote) ^ inside;
+      inside = 0 - (in_literal >> 63);
+      std::uint64_t bits = ((m.eq | m.comma) & ~in_literal) | m.quote;
+      for (; bits != 0; bits &= bits - 1)
+        index.positions.push_back(static_cast<std::uint32_t>(
+          base + static_cast<std::size_t>(std::countr_zero(bits))));
+    }
+    index.unclosed_quote = inside != 0;
+    return index;
+  }
+
+  /// Inputs from this size are parsed through the structural index
+  inline constexpr std::size_t structural_index_threshold = 64 * 1024;
+
+  /// Largest input the index can address
+  inline constexpr std::size_t structural_index_max_size =
+    std::numeric_limits<std::uint32_t>::max();
+} // namespace namedargs
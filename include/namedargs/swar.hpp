@@ -0,0 +1,85 @@
+/// @file swar.hpp
+#pragma once
+#include <bit>     // std::endian
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::memcpy
+#include <string_view>
+#include <type_traits> // std::is_constant_evaluated
+
+namespace namedargs {
+  // SIMD within a register: 8 bytes processed as one 64-bit word
+
+  /// Loads 8 bytes as a little-endian word, so byte `i` is bits [8i, 8i + 8)
+  constexpr std::uint64_t load_u64(const char* p) noexcept {
+    std::uint64_t x = 0;
+    if (std::is_constant_evaluated()) {
+      for (std::size_t i = 0; i < 8; ++i)
+        x |= std::uint64_t{static_cast<unsigned char>(p[i])} << (8 * i);
+    } else {
+      std::memcpy(&x, p, sizeof(x));
+      if constexpr (std::endian::native == std::endian::big)
+        x = __builtin_bswap64(x);
+    }
+    return x;
+  }
+
+  inline constexpr std::uint64_t swar_ones = 0x0101010101010101;
+  inline constexpr std::uint64_t swar_high = 0x8080808080808080;
+  inline constexpr std::uint64_t swar_low7 = 0x7F7F7F7F7F7F7F7F;
+
+  // The following set the high bit of each byte of the result whose byte in
+  // `x` matches, and clear all other bits.
+
+  constexpr std::uint64_t swar_eq(std::uint64_t x, char c) noexcept {
+    const std::uint64_t y = x ^ (swar_ones * static_cast<unsigned char>(c));
+    return ~(((y & swar_low7) + swar_low7) | y | swar_low7);
+  }
+
+  /// Bytes in [lo, hi], where 0 < lo <= hi < 0x7F
+  constexpr std::uint64_t swar_between(std::uint64_t x, char lo,
+                                       char hi) noexcept {
+    const auto ge =
+      (x & swar_low7) + swar_ones * static_cast<unsigned>(0x80 - lo);
+    const auto gt =
+      (x & swar_low7) + swar_ones * static_cast<unsigned>(0x7F - hi);
+    return ge & ~gt & ~x & swar_high;
+  }
+
+  constexpr std::uint64_t swar_digit(std::uint64_t x) noexcept {
+    return swar_between(x, '0', '9');
+  }
+
+  /// Fixed layout of 8 bytes: '0' stands for any digit, '?' for any byte and
+  /// other characters for themselves (letters case-insensitively)
+  struct swar_pattern {
+    std::uint64_t digits = 0;  // High bits of the digit positions
+    std::uint64_t literal = 0; // Expected bits at the literal positions
+    std::uint64_t mask = 0;    // Compared bits at the literal positions
+  };
+
+  constexpr swar_pattern make_swar_pattern(std::string_view pattern) {
+    swar_pattern p{};
+    for (std::size_t i = 0; i < pattern.size() and i < 8; ++i) {
+      const auto c = static_cast<unsigned char>(pattern[i]);
+      const bool alpha = ('A' <= c and c <= 'Z') or ('a' <= c and c <= 'z');
+      if (c == '0')
+        p.digits |= std::uint64_t{0x80} << (8 * i);
+      else if (c != '?') {
+        p.literal |= std::uint64_t{alpha ? c & 0xDFu : c} << (8 * i);
+        p.mask |= std::uint64_t{alpha ? 0xDFu : 0xFFu} << (8 * i);
+      }
+    }
+    return p;
+  }
+
+  constexpr bool swar_match(std::uint64_t x, const swar_pattern& p) noexcept {
+    return ((swar_digit(x) & p.digits) == p.digits)
+           & ((x & p.mask) == p.literal);
+  }
+
+  /// Byte `i` of `x`
+  constexpr unsigned swar_byte(std::uint64_t x, std::size_t i) noexcept {
+    return static_cast<unsigned>(x >> (8 * i) & 0xFF);
+  }
+} // namespace namedargs
@@ -0,0 +1,106 @@
+/// @file value.hpp
+#pragma once
+#include <concepts>    // std::equality_comparable
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint8_t
+#include <type_traits> // std::is_trivially_copyable_v
+#include <utility>     // std::forward, std::in_place_index_t
+
+namespace namedargs {
+  // A tagged union of literal values, the type of parsed arguments in place
+  // of std::variant: the alternatives are trivially copyable, so the union
+  // needs no special members, and `visit` compares the one-byte tag in a
+  // chain the compiler turns into a switch, with no table of functions.
+
+  template <class... Types>
+  union value_storage {};
+
+  template <class T, class... Rest>
+  union value_storage<T, Rest...> {
+    T first;
+    value_storage<Rest...> rest;
+
+    template <class... Args>
+    constexpr explicit value_storage(std::in_place_index_t<0>, Args&&... args)
+      : first(std::forward<Args>(args)...) {}
+
+    template <std::size_t I, class... Args>
+    constexpr explicit value_storage(std::in_place_index_t<I>, Args&&... args)
+      : rest(std::in_place_index<I - 1>, std::forward<Args>(args)...) {}
+  };
+
+  template <class... Types>
+  class tagged_value {
+    static_assert(sizeof...(Types) != 0 and sizeof...(Types) <= 255);
+    static_assert((std::is_trivially_copyable_v<Types> and ...)
+                    and (std::is_trivially_destructible_v<Types> and ...),
+                  "value kinds must be trivially copyable");
+
+  public:
+    /// Holds a value-initialized first alternative, like std::variant
+    constexpr tagged_value() : storage_(std::in_place_index<0>), tag_(0) {}
+
+    template <std::size_t I, class... Args>
+    constexpr explicit tagged_value(std::in_place_index_t<I> i,
+                                    Args&&... args)
+      : storage_(i, std::forward<Args>(args)...),
+        tag_(static_cast<std::uint8_t>(I)) {}
+
+    /// Index of the alternative held
+    constexpr std::size_t index() const noexcept { return tag_; }
+
+    /// The alternative `I`, which must be the one held
+    template <std::size_t I>
+    constexpr const auto& get() const noexcept {
+      return get_from<I>(storage_);
+    }
+
+    /// Calls `f` with the alternative held. Every call must return the same
+    /// type.
+    template <class F, std::size_t I = 0>
+    constexpr decltype(auto) visit(F&& f) const {
+      if constexpr (I + 1 == sizeof...(Types))
+        return std::forward<F>(f)(get<I>());
+      else if (tag_ == I)
+        return std::forward<F>(f)(get<I>());
+      else
+        return visit<F, I + 1>(std::forward<F>(f));
+    }
+
+    friend constexpr bool operator==(const tagged_value& x,
+                                     const tagged_value& y)
+      requires(std::equality_comparable<Types> and ...)
+    {
+      return x.tag_ == y.tag_ and x.equal_to(y);
+    }
+
+  private:
+    template <std::size_t I, class S>
+    static constexpr const auto& get_from(const S& s) noexcept {
+      if constexpr (I == 0)
+        return s.first;
+      else
+        return get_from<I - 1>(s.rest);
+    }
+
+    /// Compares the alternatives of `*this` and `y`, both the one held
+    template <std::size_t I = 0>
+    constexpr bool equal_to(const tagged_value& y) const {
+      if constexpr (I + 1 == sizeof...(Types))
+        return get<I>() == y.template get<I>();
+      else if (tag_ == I)
+        return get<I>() == y.template get<I>();
+      else
+        return equal_to<I + 1>(y);
+    }
+
+    value_storage<Types...> storage_;
+    std::uint8_t tag_;
+  };
+
+  /// Calls `f` with the alternative held by `v`
+  template <class F, class... Types>
+  constexpr decltype(auto) visit(F&& f, const tagged_value<Types...>& v) {
+    return v.visit(std::forward<F>(f));
+  }
+} // namespace namedargs
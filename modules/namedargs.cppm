@@ -0,0 +1,103 @@
+/// @file namedargs.cppm
+/// The `namedargs` named module, experimental: the headers are the supported
+/// interface. Macros cannot be exported; include <namedargs/aggregate.hpp>
+/// for `NAMEDARGS_AGGREGATE` or call `convert_aggregate` directly.
+module;
+#include <namedargs/address.hpp>
+#include <namedargs/aggregate.hpp>
+#include <namedargs/async.hpp>
+#include <namedargs/convert.hpp>
+#include <namedargs/datetime.hpp>
+#include <namedargs/parser.hpp>
+#include <namedargs/simd.hpp>
+#include <namedargs/sort.hpp>
+#include <namedargs/structural.hpp>
+#include <namedargs/unicode.hpp>
+#include <namedargs/value.hpp>
+export module namedargs;
+
+export namespace namedargs {
+  // parser.hpp
+  using namedargs::ArgChecker;
+  using namedargs::ArgParser;
+  using namedargs::ArgParserOptions;
+  using namedargs::ArgParserTraits;
+  using namedargs::assign_arg;
+  using namedargs::BasicArgParser;
+  using namedargs::BasicToken;
+  using namedargs::error_buffer;
+  using namedargs::int_kind;
+  using namedargs::key_error;
+  using namedargs::parse_args;
+  using namedargs::parse_error;
+  using namedargs::parser_pool;
+  using namedargs::parser_pool_max_bytes;
+  using namedargs::parser_pool_max_size;
+  using namedargs::string_kind;
+  using namedargs::Token;
+  using namedargs::TokenKind;
+  using namedargs::variant_assignable_from_any_v;
+
+  // convert.hpp
+  using namedargs::convert_fields;
+  using namedargs::convert_fields_recover;
+  using namedargs::field;
+  using namedargs::field_descriptor;
+  using namedargs::ignore_unknown;
+  using namedargs::merge_join;
+  using namedargs::parse_args_direct;
+  using namedargs::parse_fields;
+  using namedargs::reject_unknown;
+  using namedargs::required;
+  using namedargs::required_t;
+  using namedargs::sorted_order;
+
+  // aggregate.hpp
+  using namedargs::aggregate_arity;
+  using namedargs::convert_aggregate;
+  using namedargs::count_field_names;
+  using namedargs::split_field_names;
+  using namedargs::tie_fields;
+
+  // async.hpp
+  using namedargs::default_thread_pool;
+  using namedargs::executor;
+  using namedargs::inline_executor;
+  using namedargs::parse_args_async;
+  using namedargs::thread_pool;
+
+  // address.hpp, datetime.hpp
+  using namedargs::address_kind;
+  using namedargs::datetime_kind;
+  using namedargs::ip_address;
+
+  // unicode.hpp
+  using namedargs::decode_utf8;
+  using namedargs::find_invalid_utf8;
+  using namedargs::is_xid_continue;
+  using namedargs::is_xid_start;
+
+  // simd.hpp
+  using namedargs::char_class;
+  using namedargs::scan_kernels;
+  using namedargs::scan_kernels_for;
+  using namedargs::selected_simd_level;
+  using namedargs::simd_level;
+  using namedargs::span_class;
+  using namedargs::supported_simd_level;
+  using namedargs::use_simd_level;
+
+  // structural.hpp
+  using namedargs::build_structural_index;
+  using namedargs::structural_index;
+  using namedargs::structural_index_threshold;
+
+  // value.hpp
+  using namedargs::tagged_value;
+  using namedargs::visit;
+
+  // sort.hpp
+  using namedargs::key_prefix;
+  using namedargs::msd_sort;
+  using namedargs::prefixed_key;
+} // namespace namedargs
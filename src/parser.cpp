@@ -0,0 +1,9 @@
+/// @file parser.cpp
+/// Explicit instantiation of `ArgParser` for the compiled library
+/// `Iris::Compiled`. Translation units linking it see the `extern template`
+/// declaration in parser.hpp and call the runtime path defined here.
+#include <namedargs/parser.hpp>
+
+namespace namedargs {
+  template struct BasicArgParser<int_kind, string_kind>;
+} // namespace namedargs
@@ -0,0 +1,734 @@
+#include <catch2/catch_test_macros.hpp>
+#include <namedargs/address.hpp>
+#include <namedargs/async.hpp>
+#include <namedargs/aggregate.hpp>
+#include <namedargs/datetime.hpp>
+
+namespace na = namedargs;
+
+namespace {
+  struct aggregate_params {
+    std::int64_t num = -1;
+    std::string_view str;
+    std::int64_t other = 7;
+  };
+} // namespace
+
+NAMEDARGS_AGGREGATE(aggregate_params, num, str, other);
+
+TEST_CASE("aggregate", "[parser][aggregate]") {
+  static_assert(na::aggregate_arity<aggregate_params>() == 3);
+  constexpr auto p =
+    na::parse_args<aggregate_params>("str = 'Hello', num = 42, dummy = 0");
+  static_assert(p.num == 42 and p.str == "Hello" and p.other == 7);
+  const auto q = na::parse_args<aggregate_params>("other = 1");
+  CHECK(q.num == -1);
+  CHECK(q.str.empty());
+  CHECK(q.other == 1);
+  CHECK_THROWS_AS(na::parse_args<aggregate_params>("num = 'x'"),
+                  na::parse_error);
+}
+
+namespace {
+  struct field_params {
+    std::int64_t num;
+    std::string_view str;
+  };
+} // namespace
+
+template <>
+struct na::ArgParserTraits<field_params> {
+  static constexpr auto fields = std::tuple{
+    na::field("str", &field_params::str, ""),
+    na::field("num", &field_params::num, 0),
+  };
+  static constexpr field_params convert(const na::ArgParser& p) {
+    return na::convert_fields<field_params, fields>(p);
+  }
+};
+
+TEST_CASE("convert_fields", "[parser][convert]") {
+  constexpr auto p = na::parse_args<field_params>("num = 42");
+  static_assert(p.num == 42 and p.str.empty());
+
+  na::ArgParser parser("a = 1, num = 2, z = 3");
+  parser.execute();
+  std::size_t unknowns = 0;
+  const auto q = na::convert_fields<field_params,
+                                    na::ArgParserTraits<field_params>::fields>(
+    parser, [&unknowns](std::string_view) { ++unknowns; });
+  CHECK(q.num == 2);
+  CHECK(unknowns == 2);
+}
+
+namespace {
+  struct strict_params {
+    std::int64_t num;
+    std::string_view str;
+  };
+
+  constexpr auto strict_fields = std::tuple{
+    na::required("num", &strict_params::num),
+    na::field("str", &strict_params::str, ""),
+  };
+
+  strict_params parse_strict(std::string_view sv) {
+    na::ArgParser parser(sv);
+    parser.execute();
+    return na::convert_fields<strict_params, strict_fields>(
+      parser, na::reject_unknown{});
+  }
+} // namespace
+
+TEST_CASE("strict conversion", "[parser][convert]") {
+  CHECK(parse_strict("num = 1").num == 1);
+  try {
+    parse_strict("str = 'x'");
+    FAIL();
+  } catch (const na::key_error& e) {
+    CHECK(e.kind == na::key_error::kind_type::missing);
+    CHECK(e.key == "num");
+  }
+  try {
+    parse_strict("num = 1, nmu = 2");
+    FAIL();
+  } catch (const na::key_error& e) {
+    CHECK(e.kind == na::key_error::kind_type::unknown);
+    CHECK(e.key == "nmu");
+  }
+
+  na::ArgParser parser("num = 1, str = 'x'");
+  parser.execute();
+  na::ArgChecker checker(parser);
+  std::int64_t num{};
+  checker.assign_required(num, "num");
+  CHECK_THROWS_AS(checker.check_unknown(), na::key_error);
+  std::string_view str;
+  checker.assign_or(str, "str", "");
+  CHECK_NOTHROW(checker.check_unknown());
+  CHECK_THROWS_AS(checker.assign_required(num, "other"), na::key_error);
+}
+
+TEST_CASE("parse_fields", "[parser][convert]") {
+  constexpr auto p = na::parse_args_direct<field_params>("num = 42, s = 'x'");
+  static_assert(p.num == 42 and p.str.empty());
+  CHECK(na::parse_args_direct<field_params>("").num == 0);
+  CHECK(na::parse_args_direct<field_params>(" str = 'a' ").str == "a");
+  CHECK_THROWS_AS(na::parse_args_direct<field_params>("str = 'a\xFF'"),
+                  na::parse_error);
+  CHECK(na::parse_args_direct<field_params>("str = 'a\xFF'",
+                                            {.validate_utf8 = false})
+          .str
+        == "a\xFF");
+  CHECK_THROWS_AS(na::parse_args_direct<field_params>("num = 1, num = 2"),
+                  na::parse_error);
+  CHECK_THROWS_AS(na::parse_args_direct<field_params>("num = 1,"),
+                  na::parse_error);
+  CHECK_THROWS_AS(na::parse_args_direct<field_params>("num 1"),
+                  na::parse_error);
+  CHECK_THROWS_AS(na::parse_args_direct<field_params>("num = 1 str"),
+                  na::parse_error);
+  CHECK_THROWS_AS((na::parse_fields<strict_params, strict_fields>("str = 'a'")),
+                  na::key_error);
+}
+
+TEST_CASE("parse_error position", "[parser][error]") {
+  try {
+    na::parse_args<field_params>("num = 1,\nstr = ");
+    FAIL();
+  } catch (const na::parse_error& e) {
+    CHECK(e.offset() == 15);
+    CHECK(e.expected() == "value");
+    CHECK(std::string_view(e.what()).starts_with("2:7: "));
+    CHECK(e.format().ends_with("str = \n      ^\nexpected: value"));
+  }
+  try {
+    na::parse_args_direct<field_params>("num = 1 str");
+    FAIL();
+  } catch (const na::parse_error& e) {
+    CHECK(e.offset() == 8);
+  }
+  CHECK(na::parse_error("message").offset() == std::string_view::npos);
+
+  // The message outlives the input
+  std::optional<na::parse_error> error;
+  try {
+    na::parse_args<field_params>(std::string("num = 1,\nstr = "));
+  } catch (const na::parse_error& e) {
+    error.emplace(e);
+  }
+  REQUIRE(error);
+  CHECK(std::string_view(error->what())
+          .ends_with("str = \n      ^\nexpected: value"));
+}
+
+namespace {
+  // Rejects every literal starting with '#' with an error without position
+  struct reserved_kind {
+    using value_type = char;
+    static constexpr bool first(char c) { return c == '#'; }
+    static std::size_t scan(std::string_view, char&,
+                            const na::ArgParserOptions&) {
+      throw na::parse_error("reserved literal");
+    }
+  };
+} // namespace
+
+TEST_CASE("recovery mode", "[parser][error]") {
+  na::error_buffer errors;
+  na::ArgParser parser(
+    "num = 'x', a = , b = 1 2, c = 3, c = 4, d = #, e = 5, str = 'unclosed");
+  CHECK_FALSE(parser.execute_recover(errors));
+  REQUIRE(errors.count() == 5);
+  CHECK(errors.errors()[0].offset() == 15);
+  CHECK(std::string_view(errors.errors()[2].what()).find("already exists")
+        != std::string_view::npos);
+  REQUIRE(parser.args().size() == 4);
+
+  const auto p = na::convert_fields_recover<
+    strict_params, strict_fields>(parser, errors, na::reject_unknown{});
+  CHECK(p.str.empty());
+  CHECK(errors.count() == 5 + 4);
+
+  na::error_buffer small(2);
+  na::ArgParser parser2("a = , b = , c = ");
+  CHECK_FALSE(parser2.execute_recover(small));
+  CHECK(small.errors().size() == 2);
+  CHECK(small.dropped() == 1);
+
+  na::error_buffer none;
+  na::ArgParser parser3("a = 1");
+  CHECK(parser3.execute_recover(none));
+  CHECK(none.empty());
+  // Starts over after `execute()`
+  na::ArgParser executed("a = 1, b = 2");
+  executed.execute();
+  CHECK(executed.execute_recover(none));
+  CHECK(executed.args().size() == 2);
+
+  // Invalid UTF-8 inside a literal: resumes after the whole literal
+  for (std::string_view input : {"s = 'a\xFF" "b, c', t = 1",
+                                 "s = 'a, \xFF', t = 1"}) {
+    na::error_buffer utf8;
+    na::ArgParser parser5(input);
+    CHECK_FALSE(parser5.execute_recover(utf8));
+    CHECK(utf8.count() == 1);
+    REQUIRE(parser5.args().size() == 1);
+    CHECK(parser5.args()[0].first == "t");
+  }
+
+  na::error_buffer reserved;
+  na::BasicArgParser<na::int_kind, reserved_kind> parser4("a = #1, b = 2");
+  CHECK_FALSE(parser4.execute_recover(reserved));
+  CHECK(reserved.count() == 1);
+  REQUIRE(parser4.args().size() == 1);
+  CHECK(parser4.args()[0].first == "b");
+}
+
+TEST_CASE("UTF-8", "[parser][unicode]") {
+  constexpr auto npos = std::string_view::npos;
+  static_assert(
+    na::ascii_prefix_length("0123456789abcdef0123456789abcdef01\xC3") == 34);
+  static_assert(na::find_invalid_utf8("h\xC3\xA9llo \xE3\x81\x82") == npos);
+  static_assert(na::find_invalid_utf8("\xC0\xAF") == 0);         // overlong
+  static_assert(na::find_invalid_utf8("ab\xED\xA0\x80") == 2);   // surrogate
+  static_assert(na::find_invalid_utf8("\xF4\x90\x80\x80") == 0); // > U+10FFFF
+  static_assert(na::find_invalid_utf8("\xE3\x81") == 0);         // truncated
+
+  constexpr auto p = na::parse_args<field_params>("str = 'こんにちは'");
+  static_assert(p.str == "こんにちは");
+  CHECK_THROWS_AS(na::parse_args<field_params>("str = 'a\xFF'"),
+                  na::parse_error);
+  CHECK_THROWS_AS(na::parse_args<field_params>("数 = 1"), na::parse_error);
+
+  na::ArgParser parser("数 = 1, straße = 'x', x数2 = 3",
+                       {.unicode_identifiers = true});
+  parser.execute();
+  std::int64_t num{};
+  CHECK(parser.assign_or(num, "数", 0) == 1);
+  CHECK(parser.assign_or(num, "x数2", 0) == 3);
+  CHECK(parser.find("straße").second);
+  na::ArgParser bad("a\xE2\x80\x8B = 1", {.unicode_identifiers = true});
+  CHECK_THROWS_AS(bad.execute(), na::parse_error); // U+200B is not XID
+}
+
+namespace {
+  // `true` or `false`; other identifiers fall through to TokenKind::ident
+  struct bool_kind {
+    using value_type = bool;
+    static constexpr bool first(char c) { return c == 't' or c == 'f'; }
+    static constexpr std::size_t
+    scan(std::string_view sv, bool& out, const na::ArgParserOptions&) {
+      for (std::string_view word : {"true", "false"})
+        if (sv.starts_with(word)
+            and (sv.size() == word.size() or not na::isident2(sv[word.size()])))
+          return out = word == "true", word.size();
+      return 0;
+    }
+  };
+
+  using bool_parser = na::BasicArgParser<na::int_kind, na::string_kind,
+                                         bool_kind>;
+
+  struct flag_params {
+    bool flag;
+    std::int64_t num;
+  };
+} // namespace
+
+template <>
+struct na::ArgParserTraits<flag_params> {
+  static constexpr flag_params convert(const bool_parser& p) {
+    na::ArgChecker checker(p);
+    flag_params result{};
+    checker.assign_or(result.flag, "flag", false);
+    checker.assign_or(result.num, "num", 0);
+    checker.check_unknown();
+    return result;
+  }
+};
+
+TEST_CASE("user-defined value kinds", "[parser][kind]") {
+  static_assert(bool_parser::kind_table['t'] == 0b100);
+  static_assert(bool_parser::kind_table['\''] == 0b010);
+  constexpr auto p =
+    na::parse_args<flag_params, bool_parser>("flag = true, num = 3");
+  static_assert(p.flag and p.num == 3);
+  CHECK_FALSE(na::parse_args<flag_params, bool_parser>("flag = false").flag);
+  CHECK_THROWS_AS((na::parse_args<flag_params, bool_parser>("flag = truth")),
+                  na::parse_error);
+  try {
+    bool_parser("flag = ,").execute();
+    FAIL();
+  } catch (const na::parse_error& e) {
+    CHECK(std::string_view(e.what()).find("expecting a value")
+          != std::string_view::npos);
+    CHECK(e.expected() == "value");
+  }
+  CHECK_THROWS_AS((na::parse_args<flag_params, bool_parser>("t = 1")),
+                  na::key_error);
+}
+
+namespace {
+  using inet_parser =
+    na::BasicArgParser<na::address_kind, na::int_kind, na::string_kind>;
+
+  constexpr na::ip_address parse_address(std::string_view sv) {
+    inet_parser parser(sv);
+    parser.execute();
+    na::ip_address a{};
+    parser.assign_or(a, "a", na::ip_address{});
+    return a;
+  }
+} // namespace
+
+TEST_CASE("address literals", "[parser][address]") {
+  constexpr auto a = parse_address("a = 10.0.0.1:8080");
+  static_assert(a.bytes[0] == 10 and a.bytes[3] == 1 and a.port == 8080);
+  constexpr auto b = parse_address("a = 192.168.0.0/16");
+  static_assert(b.bytes[1] == 168 and b.prefix == 16);
+  constexpr auto c = parse_address("a = [::1]:53");
+  static_assert(c.family == na::ip_address::family_type::v6
+                and c.bytes[15] == 1 and c.port == 53);
+  constexpr auto d = parse_address("a = 2001:db8::ff00:42:8329/64");
+  static_assert(d.bytes[0] == 0x20 and d.bytes[3] == 0xb8
+                and d.bytes[14] == 0x83 and d.prefix == 64);
+  constexpr auto e = parse_address("a = ::ffff:1.2.3.4");
+  static_assert(e.bytes[10] == 0xFF and e.bytes[12] == 1 and e.bytes[15] == 4);
+
+  inet_parser parser("n = 42, s = 'x', abc = 1");
+  parser.execute();
+  std::int64_t n{};
+  CHECK(parser.assign_or(n, "n", 0) == 42);
+  CHECK(parser.find("abc").second);
+
+  for (std::string_view bad : {"a = 256.0.0.1", "a = 1.2.3", "a = 01.2.3.4",
+                               "a = 1:2:3", "a = 1.2.3.4/33", "a = 1::2::3"})
+    CHECK_THROWS_AS(parse_address(bad), na::parse_error);
+
+#ifdef NAMEDARGS_HAS_NETINET
+  in_addr in4{};
+  inet_parser p2("a = 127.0.0.1");
+  p2.execute();
+  p2.assign_or(in4, "a", in_addr{});
+  CHECK(ntohl(in4.s_addr) == 0x7F000001);
+  in6_addr in6{};
+  CHECK_THROWS_AS(p2.assign_or(in6, "a", in6_addr{}), na::parse_error);
+#endif
+}
+
+namespace {
+  using time_parser =
+    na::BasicArgParser<na::datetime_kind, na::int_kind, na::string_kind>;
+
+  constexpr na::datetime_kind::value_type parse_time(std::string_view sv) {
+    time_parser parser(sv);
+    parser.execute();
+    na::datetime_kind::value_type t{};
+    parser.assign_or(t, "t", na::datetime_kind::value_type{});
+    return t;
+  }
+} // namespace
+
+TEST_CASE("datetime literals", "[parser][datetime]") {
+  using namespace std::chrono;
+  constexpr auto noon = sys_days{2026y / October / 16} + 12h;
+  static_assert(parse_time("t = 2026-10-16T12:00:00Z") == noon);
+  static_assert(parse_time("t = 2026-10-16") == sys_days{2026y / 10 / 16});
+  static_assert(parse_time("t = 2026-10-16t21:30:00.25+09:30")
+                == noon + 250ms);
+  static_assert(parse_time("t = 2024-02-29T00:00:00-01:00")
+                == sys_days{2024y / 2 / 29} + 1h);
+
+  time_parser parser("n = 2026, t = 2026-01-01");
+  parser.execute();
+  std::int64_t n{};
+  CHECK(parser.assign_or(n, "n", 0) == 2026);
+
+  for (std::string_view bad :
+       {"t = 2026-13-01", "t = 2025-02-29", "t = 2026-1-01",
+        "t = 2026-10-16T24:00:00Z", "t = 2026-10-16T12:00:00+0900",
+        "t = 2026-10-16T12:00:00.Z", "t = 2026-10-16x"})
+    CHECK_THROWS_AS(parse_time(bad), na::parse_error);
+}
+
+TEST_CASE("scan kernels", "[parser][simd]") {
+  using na::char_class;
+  static_assert(na::span_class("  \t\n x", char_class::space) == 5);
+  static_assert(na::span_class("abc_09+", char_class::ident, 1) == 6);
+
+  // Every level the CPU supports agrees with the byte-by-byte definition
+  std::string s;
+  for (std::size_t i = 0; i < 300; ++i)
+    s += "  a_Z9'\t\xC3\xA9-0"[i * 5 % 13];
+  const auto top = na::supported_simd_level();
+  for (unsigned l = 0; l <= static_cast<unsigned>(top); ++l) {
+    const auto kernels = na::scan_kernels_for(static_cast<na::simd_level>(l));
+    for (unsigned c = 0; c < na::char_class_count; ++c)
+      for (std::size_t pos = 0; pos < s.size(); ++pos) {
+        const auto cls = static_cast<char_class>(c);
+        std::size_t expected = pos;
+        while (expected < s.size() and na::in_class(s[expected], cls))
+          ++expected;
+        CHECK(pos + kernels.span[c](s.data() + pos, s.size() - pos)
+              == expected);
+      }
+  }
+
+  const std::string input =
+    "a = 123456789012345678, b = 1234567890123456789, c = '"
+    + std::string(100, 'x') + "'";
+  na::ArgParser parser(input);
+  parser.execute();
+  std::int64_t a = 0, b = 0;
+  std::string_view c;
+  CHECK(parser.assign_or(a, "a", 0) == 123456789012345678);
+  CHECK(parser.assign_or(b, "b", 0) == 1234567890123456789);
+  CHECK(parser.assign_or(c, "c", "") == std::string(100, 'x'));
+}
+
+TEST_CASE("structural index", "[parser][structural]") {
+  const auto index = na::build_structural_index("a = 'x,=y', b = 2");
+  CHECK(index.positions == std::vector<std::uint32_t>{2, 4, 9, 10, 14});
+  CHECK(not index.unclosed_quote);
+  CHECK(na::build_structural_index("a = 'x").unclosed_quote);
+
+  // Large enough for `execute()` to take the indexed path
+  std::string input;
+  for (std::size_t i = 0; input.size() < na::structural_index_threshold; ++i)
+    input += "key" + std::to_string(i) + " = 'v,=" + std::to_string(i)
+             + "', num" + std::to_string(i) + " = " + std::to_string(i) + ", ";
+  input += "last = 42";
+  na::ArgParser parser(input);
+  parser.execute();
+  std::int64_t last = 0;
+  std::string_view key7;
+  CHECK(parser.assign_or(last, "last", 0) == 42);
+  CHECK(parser.assign_or(key7, "key7", "") == "v,=7");
+
+  // Errors are those of the reference path
+  const std::string duplicate = input + ", key7 = 1";
+  try {
+    na::ArgParser(duplicate).execute();
+    FAIL();
+  } catch (const na::parse_error& e) {
+    CHECK(e.offset() == duplicate.size() - 8);
+    CHECK(std::string_view(e.what()).find("already exists")
+          != std::string_view::npos);
+  }
+}
+
+TEST_CASE("tagged values", "[parser][value]") {
+  using value = na::ArgParser::ArgType;
+  constexpr value num(std::in_place_index<0>, 42);
+  constexpr value str(std::in_place_index<1>, "42");
+  static_assert(num.index() == 0 and num.get<0>() == 42);
+  static_assert(str.index() == 1 and str.get<1>() == "42");
+  static_assert(value().index() == 0 and value().get<0>() == 0);
+  static_assert(num == value(std::in_place_index<0>, 42));
+  static_assert(num != str and num != value());
+  static_assert(na::visit([](auto x) { return sizeof(x); }, str)
+                == sizeof(std::string_view));
+
+  std::int64_t n = 0;
+  CHECK(na::assign_arg(n, num) == 42);
+  CHECK_THROWS_AS(na::assign_arg(n, str), na::parse_error);
+}
+
+TEST_CASE("radix sort", "[parser][sort]") {
+  constexpr auto sorted = [] {
+    std::array<std::string_view, 4> keys{"b", "ab", "a", "\xFF"};
+    na::msd_sort(keys.begin(), keys.end(), [](auto k) { return k; });
+    return keys;
+  }();
+  static_assert(sorted == std::array<std::string_view, 4>{"a", "ab", "b",
+                                                          "\xFF"});
+
+  // Common prefixes, bytes above 0x7F and keys ending inside others
+  std::vector<std::string> strings;
+  for (std::size_t i = 0; i < 3000; ++i)
+    strings.push_back(std::string(i % 5, 'k') + static_cast<char>(i * 37 % 256)
+                      + std::to_string(i % 1000 + i / 1000 * 7));
+  std::vector<std::string_view> keys(strings.begin(), strings.end());
+  auto expected = keys;
+  std::ranges::sort(expected);
+  const bool distinct =
+    std::ranges::adjacent_find(expected) == expected.end();
+  CHECK(na::msd_sort(keys.begin(), keys.end(), [](auto k) { return k; })
+        == distinct);
+  CHECK(keys == expected);
+  keys.push_back(keys[1234]);
+  CHECK_FALSE(
+    na::msd_sort(keys.begin(), keys.end(), [](auto k) { return k; }));
+
+  // Long shared prefixes: 40 keys after 20000 equal bytes, and keys of
+  // 1 to 3000 bytes each extending the previous one's prefix
+  for (const auto& [count, key_of] :
+       {std::pair<std::size_t, std::string (*)(std::size_t)>{
+          40,
+          [](std::size_t i) {
+            return std::string(20000, 'p') + std::to_string(i * 7 % 40);
+          }},
+        {3000,
+         [](std::size_t i) { return std::string(i * 7 % 3000, 'a') + 'b'; }}}) {
+    strings.clear();
+    std::string input;
+    for (std::size_t i = 0; i < count; ++i) {
+      strings.push_back(key_of(i));
+      input += strings.back() + " = 1, ";
+    }
+    keys.assign(strings.begin(), strings.end());
+    expected = keys;
+    std::ranges::sort(expected);
+    CHECK(na::msd_sort(keys.begin(), keys.end(), [](auto k) { return k; }));
+    CHECK(keys == expected);
+    input += strings.front() + " = 2";
+    CHECK_THROWS_AS(na::ArgParser(input).execute(), na::parse_error);
+    input.resize(input.rfind(','));
+    na::ArgParser parser(input);
+    parser.execute();
+    CHECK(std::ranges::equal(parser.keys(), expected));
+  }
+
+  // The first repetition in the input is reported, even before an error
+  for (auto [input, offset] : {std::pair{"b = 1, a = 2, b = 3, a = 4", 14},
+                               std::pair{"b = 1, a = 2, a = 3, b = 4", 14},
+                               std::pair{"a = 1, a 2", 7},
+                               std::pair{"a = 1, a = , b = 1", 7},
+                               std::pair{"a = 1, b = , a = 1", 11}}) {
+    try {
+      na::ArgParser(input).execute();
+      FAIL();
+    } catch (const na::parse_error& e) {
+      CHECK(e.offset() == static_cast<std::size_t>(offset));
+    }
+  }
+}
+
+TEST_CASE("prefixed keys", "[parser][sort]") {
+  static_assert(na::key_prefix("ab") == 0x6162000000000000);
+  static_assert(na::key_prefix("abcdefghij") == 0x6162636465666768);
+  static_assert(na::prefixed_key("abcdefgh") < na::prefixed_key("abcdefghi"));
+  static_assert(na::prefixed_key("b") > na::prefixed_key("abcdefghi"));
+  // Equal prefixes of different keys, zero padding included
+  using namespace std::literals;
+  static_assert(na::prefixed_key("a") < na::prefixed_key("a\0"sv));
+  static_assert(na::prefixed_key("a") != na::prefixed_key("a\0"sv));
+
+  // Lookups among keys sharing their first 8 bytes or more
+  std::string input;
+  for (std::size_t i = 0; i < 300; ++i)
+    input += (i == 0 ? "" : ", ") + ("long_key" + std::to_string(i * 7))
+             + " = " + std::to_string(i) + ", k" + std::to_string(i) + " = 1";
+  na::ArgParser parser(input);
+  parser.execute();
+  for (std::size_t i = 0; i < 300; ++i) {
+    std::int64_t value = -1;
+    CHECK(parser.assign_or(value, "long_key" + std::to_string(i * 7), -1)
+          == static_cast<std::int64_t>(i));
+    CHECK_FALSE(parser.find("long_key" + std::to_string(i * 7 + 1)).second);
+    CHECK(parser.find("k" + std::to_string(i)).second);
+  }
+  CHECK_FALSE(parser.find("long_key").second);
+  CHECK_FALSE(parser.find("").second);
+  CHECK_FALSE(parser.find("zzz").second);
+
+  // Same results in the frozen layout, at every tree size
+  static_assert([] {
+    na::ArgParser p("b = 1, a = 2, c = 3");
+    p.execute();
+    p.freeze();
+    return p.find("c").second and not p.find("d").second;
+  }());
+  for (std::size_t n = 0; n <= 40; ++n) {
+    std::string small;
+    for (std::size_t i = 0; i < n; ++i)
+      small += (i == 0 ? "" : ", ") + ("key_long" + std::to_string(i * 2))
+               + " = " + std::to_string(i);
+    na::ArgParser frozen(small);
+    frozen.execute();
+    frozen.freeze();
+    CHECK(frozen.frozen());
+    for (std::size_t i = 0; i <= 2 * n; ++i) {
+      const auto [it, found] = frozen.find("key_long" + std::to_string(i));
+      CHECK(found == (i % 2 == 0 and i < 2 * n));
+      if (found)
+        CHECK(it->first == "key_long" + std::to_string(i));
+    }
+    CHECK_FALSE(frozen.find("a").second);
+    CHECK_FALSE(frozen.find("z").second);
+  }
+  // Columns parallel to args()
+  REQUIRE(parser.keys().size() == parser.args().size());
+  for (std::size_t i = 0; i < parser.args().size(); ++i) {
+    CHECK(parser.keys()[i] == parser.args()[i].first);
+    CHECK(parser.kinds()[i] == parser.args()[i].second.index());
+  }
+  na::ArgParser mixed("c = 'x', a = 1, b = 'y'");
+  mixed.execute();
+  CHECK(std::ranges::equal(mixed.kinds(),
+                           std::array<std::uint8_t, 3>{0, 1, 1}));
+
+  parser.freeze();
+  for (std::size_t i = 0; i < 300; ++i) {
+    std::int64_t value = -1;
+    CHECK(parser.assign_or(value, "long_key" + std::to_string(i * 7), -1)
+          == static_cast<std::int64_t>(i));
+    CHECK_FALSE(parser.find("long_key" + std::to_string(i * 7 + 1)).second);
+  }
+}
+
+TEST_CASE("parallel parse", "[parser][parallel]") {
+  // String literals with commas straddle the chunk boundaries
+  std::string input;
+  for (std::size_t i = 0; i < 2000; ++i)
+    input += (i == 0 ? "" : ", ") + ("k" + std::to_string(i)) + " = "
+             + (i % 3 == 0 ? "'" + std::string(i % 97, ',') + "'"
+                           : std::to_string(i));
+  na::ArgParser reference(input);
+  reference.execute();
+  for (unsigned threads : {2u, 3u, 7u, 16u}) {
+    na::ArgParser parser(input);
+    parser.execute_parallel(threads);
+    CHECK(std::ranges::equal(parser.args(), reference.args()));
+  }
+
+  // Errors, including duplicates across chunks, are the sequential ones
+  for (const std::string& bad :
+       {input + ", k1 = 2", input + ", 'x' = 1", "a = 1, " + input + ","}) {
+    std::string expected;
+    try {
+      na::ArgParser(bad).execute();
+    } catch (const na::parse_error& e) {
+      expected = e.what();
+    }
+    CHECK_FALSE(expected.empty());
+    CHECK_THROWS_AS(na::ArgParser(bad).execute_parallel(4), na::parse_error);
+    try {
+      na::ArgParser(bad).execute_parallel(4);
+    } catch (const na::parse_error& e) {
+      CHECK(e.what() == expected);
+    }
+  }
+}
+
+TEST_CASE("parser pool", "[parser][pool]") {
+  using pool = na::parser_pool<na::ArgParser>;
+  CHECK(na::parse_args<field_params>("num = 1").num == 1);
+  const std::size_t kept = pool::size();
+  REQUIRE(kept >= 1);
+  // Reused, also after an error
+  CHECK(na::parse_args<field_params>("num = 2, str = 'y'").str == "y");
+  CHECK_THROWS_AS(na::parse_args<field_params>("num = "), na::parse_error);
+  CHECK(pool::size() == kept);
+  {
+    auto a = pool::borrow("num = 3");
+    auto b = pool::borrow("num = 4, num = 5");
+    CHECK(pool::size() == (kept >= 2 ? kept - 2 : 0));
+    a->execute();
+    CHECK(a->args().size() == 1);
+    CHECK_THROWS_AS(b->execute(), na::parse_error);
+  }
+  CHECK(pool::size() == std::max<std::size_t>(kept, 2));
+
+  // The parser of a huge input is freed
+  std::string huge;
+  for (std::size_t i = 0; i < 30000; ++i)
+    huge += "k" + std::to_string(i) + " = " + std::to_string(i) + ", ";
+  huge += "num = 6";
+  const std::size_t before = pool::size();
+  CHECK(na::parse_args<field_params>(huge).num == 6);
+  CHECK(pool::size() == before - 1);
+}
+
+TEST_CASE("async parse", "[parser][async]") {
+  na::thread_pool pool(3);
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 50; ++i)
+    inputs.push_back("num = " + std::to_string(i) + ", str = 'x'");
+  std::vector<std::future<field_params>> futures;
+  for (const auto& input : inputs)
+    futures.push_back(
+      na::parse_args_async<field_params>(input, na::inline_executor{}, pool));
+  for (int i = 0; i < 50; ++i) {
+    const field_params p = futures[static_cast<std::size_t>(i)].get();
+    CHECK(p.num == i);
+    CHECK(p.str == "x");
+  }
+  auto bad = na::parse_args_async<field_params>("num = ", {}, pool);
+  CHECK_THROWS_AS(bad.get(), na::parse_error);
+
+  // Completion is delivered on the caller's executor
+  struct queue_executor {
+    std::mutex* mutex;
+    std::vector<std::function<void()>>* tasks;
+    void execute(std::function<void()> f) {
+      std::lock_guard lock(*mutex);
+      tasks->push_back(std::move(f));
+    }
+  };
+  std::mutex mutex;
+  std::vector<std::function<void()>> tasks;
+  auto f = na::parse_args_async<field_params>(
+    "num = 7", queue_executor{&mutex, &tasks}, pool);
+  for (;;) {
+    std::lock_guard lock(mutex);
+    if (not tasks.empty())
+      break;
+  }
+  CHECK(f.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+  tasks.front()();
+  CHECK(f.get().num == 7);
+
+  // An executor which throws leaves the worker running
+  struct throwing_executor {
+    void execute(std::function<void()>) const {
+      throw std::runtime_error("rejected");
+    }
+  };
+  auto rejected =
+    na::parse_args_async<field_params>("num = 1", throwing_executor{}, pool);
+  CHECK_THROWS_AS(rejected.get(), std::future_error);
+  CHECK(na::parse_args_async<field_params>("num = 2", {}, pool).get().num
+        == 2);
+}